@@ -0,0 +1,373 @@
+#include <QtTest>
+
+#include <QPainterPath>
+
+#include <ssplib/itemtypes.h>
+#include <ssplib/utils/svg_constants.h>
+#include <ssplib/utils/svg_path_utils.h>
+#include <ssplib/utils/transform_utils.h>
+#include <ssplib/utils/xmlelement.h>
+
+using namespace ssplib;
+
+//Inputs are taken from Inkscape 1.x exports of station plans,
+//both "Inkscape SVG" (relative, 8 digits) and "Optimized SVG" (absolute, 3 digits)
+
+static utils::XmlElement makeElement(const QString& tag, const QList<QPair<QString, QString>>& attrs)
+{
+    QXmlStreamAttributes streamAttrs;
+    for(const auto& attr : attrs)
+        streamAttrs.append(attr.first, attr.second);
+    return utils::XmlElement(tag, streamAttrs);
+}
+
+class SSPLibUtilsBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void parseNumberAndAdvance_data();
+    void parseNumberAndAdvance();
+
+    void parsePointAndAdvance_data();
+    void parsePointAndAdvance();
+
+    void convertLine();
+    void convertPolyline_data();
+    void convertPolyline();
+    void convertPath_data();
+    void convertPath();
+    void convertRect();
+
+    void parseTrackConnectionAttribute_data();
+    void parseTrackConnectionAttribute();
+    void trackConnInfoToString_data();
+    void trackConnInfoToString();
+
+    void parseStrokeWidthStyle_data();
+    void parseStrokeWidthStyle();
+
+    void parseTransformationMatrix_data();
+    void parseTransformationMatrix();
+    void combineTransform_data();
+    void combineTransform();
+};
+
+void SSPLibUtilsBenchmark::parseNumberAndAdvance_data()
+{
+    QTest::addColumn<QString>("input");
+    QTest::addColumn<int>("count");
+
+    QTest::newRow("integers") << QStringLiteral("0 0 297 210 1 4") << 6;
+    QTest::newRow("inkscape") << QStringLiteral("52.916667 68.791667 47.625002 -15.875 10.583331 -10.583333 0.26458332") << 7;
+    QTest::newRow("optimized") << QStringLiteral("52.917 68.792 100.54 84.667 -2.6458 .52917") << 6;
+    QTest::newRow("exponent") << QStringLiteral("1.0583333e-5 -2.6458333e+2 3.175e-3 5e2") << 4;
+}
+
+void SSPLibUtilsBenchmark::parseNumberAndAdvance()
+{
+    QFETCH(QString, input);
+    QFETCH(int, count);
+
+    //Check once outside measured loop
+    {
+        QStringView str(input);
+        double val = 0;
+        int n = 0;
+        while(!str.isEmpty() && utils::parseNumberAndAdvance(val, str))
+            n++;
+        QCOMPARE(n, count);
+    }
+
+    QBENCHMARK
+    {
+        QStringView str(input);
+        double val = 0;
+        while(!str.isEmpty() && utils::parseNumberAndAdvance(val, str))
+            ;
+    }
+}
+
+void SSPLibUtilsBenchmark::parsePointAndAdvance_data()
+{
+    QTest::addColumn<QString>("input");
+    QTest::addColumn<int>("count");
+
+    QTest::newRow("comma") << QStringLiteral("52.916667,68.791667 100.54167,68.791667 100.54167,84.666667 111.125,74.083334") << 4;
+    QTest::newRow("space") << QStringLiteral("52.917 68.792 100.54 68.792 100.54 84.667 111.13 74.083") << 4;
+    QTest::newRow("mixed") << QStringLiteral("10.583333 , -5.2916665 -21.166667,0 0 , 15.875") << 3;
+}
+
+void SSPLibUtilsBenchmark::parsePointAndAdvance()
+{
+    QFETCH(QString, input);
+    QFETCH(int, count);
+
+    {
+        QStringView str(input);
+        QPointF pt;
+        int n = 0;
+        while(!str.isEmpty() && utils::parsePointAndAdvance(pt, str))
+            n++;
+        QCOMPARE(n, count);
+    }
+
+    QBENCHMARK
+    {
+        QStringView str(input);
+        QPointF pt;
+        while(!str.isEmpty() && utils::parsePointAndAdvance(pt, str))
+            ;
+    }
+}
+
+void SSPLibUtilsBenchmark::convertLine()
+{
+    const utils::XmlElement e = makeElement(svg_tags::LineTag,
+                                            {{"x1", "52.916667"},
+                                             {"y1", "68.791667"},
+                                             {"x2", "100.54167"},
+                                             {"y2", "68.791667"},
+                                             {"style", "fill:none;stroke:#000000;stroke-width:0.529167px"}});
+
+    QPainterPath path;
+    QVERIFY(utils::convertElementToPath(e, path));
+
+    QBENCHMARK
+    {
+        QPainterPath p;
+        utils::convertElementToPath(e, p);
+    }
+}
+
+void SSPLibUtilsBenchmark::convertPolyline_data()
+{
+    QTest::addColumn<QString>("points");
+
+    QTest::newRow("short") << QStringLiteral("52.917,68.792 100.54,68.792 111.13,74.083");
+    QTest::newRow("long") << QStringLiteral("21.166667,42.333333 31.75,42.333333 42.333333,52.916667 63.5,52.916667 "
+                                            "74.083333,42.333333 116.41667,42.333333 127,52.916667 137.58333,52.916667 "
+                                            "148.16667,63.5 190.5,63.5 201.08333,52.916667 211.66667,52.916667");
+}
+
+void SSPLibUtilsBenchmark::convertPolyline()
+{
+    QFETCH(QString, points);
+
+    const utils::XmlElement e = makeElement(svg_tags::PolylineTag, {{"points", points}});
+
+    QPainterPath path;
+    QVERIFY(utils::convertElementToPath(e, path));
+
+    QBENCHMARK
+    {
+        QPainterPath p;
+        utils::convertElementToPath(e, p);
+    }
+}
+
+void SSPLibUtilsBenchmark::convertPath_data()
+{
+    QTest::addColumn<QString>("d");
+
+    QTest::newRow("relative") << QStringLiteral("m 52.916667,68.791667 h 47.625003 l 10.58333,5.291667 v 15.875 h -58.208333 z");
+    QTest::newRow("absolute") << QStringLiteral("M52.917 68.792H100.54L111.13 74.083V89.958H52.917Z");
+    QTest::newRow("implicit") << QStringLiteral("m 21.166667,42.333333 10.583333,0 10.583333,10.583334 21.166667,0 "
+                                                "10.583333,-10.583334 42.333337,0 10.58333,10.583334 10.58333,0 "
+                                                "10.58334,10.583333 42.33333,0");
+    QTest::newRow("curves") << QStringLiteral("m 63.5,95.25 c 5.291667,0 10.583333,-5.291667 15.875,-10.583333 "
+                                              "q 5.291667,-5.291667 10.583333,-5.291667 h 31.75");
+}
+
+void SSPLibUtilsBenchmark::convertPath()
+{
+    QFETCH(QString, d);
+
+    const utils::XmlElement e = makeElement(svg_tags::PathTag,
+                                            {{"d", d},
+                                             {"style", "fill:none;stroke:#000000;stroke-width:0.529167px"}});
+
+    QPainterPath path;
+    QVERIFY(utils::convertElementToPath(e, path));
+
+    QBENCHMARK
+    {
+        QPainterPath p;
+        utils::convertElementToPath(e, p);
+    }
+}
+
+void SSPLibUtilsBenchmark::convertRect()
+{
+    const utils::XmlElement e = makeElement(svg_tags::RectTag,
+                                            {{"x", "7.7508163"},
+                                             {"y", "71.160507"},
+                                             {"width", "57.195679"},
+                                             {"height", "27.528757"}});
+
+    QPainterPath path;
+    QVERIFY(utils::convertElementToPath(e, path));
+
+    QBENCHMARK
+    {
+        QPainterPath p;
+        utils::convertElementToPath(e, p);
+    }
+}
+
+void SSPLibUtilsBenchmark::parseTrackConnectionAttribute_data()
+{
+    QTest::addColumn<QString>("value");
+    QTest::addColumn<int>("count");
+
+    QTest::newRow("single") << QStringLiteral("(A,0,1,W)") << 1;
+    QTest::newRow("old_format") << QStringLiteral("(A, 0, 1), (B, 1, 2)") << 2;
+    QTest::newRow("yard") << QStringLiteral("(A,0,1,W),(A,0,2,W),(A,1,3,W),(A,1,4,W),(B,0,1,E),"
+                                            "(B,0,2,E),(B,1,3,E),(B,1,4,E),(C,0,5,W),(C,0,6,W)") << 10;
+}
+
+void SSPLibUtilsBenchmark::parseTrackConnectionAttribute()
+{
+    QFETCH(QString, value);
+    QFETCH(int, count);
+
+    {
+        QList<TrackConnectionInfo> vec;
+        QVERIFY(utils::parseTrackConnectionAttribute(value, vec));
+        QCOMPARE(vec.size(), count);
+    }
+
+    QBENCHMARK
+    {
+        QList<TrackConnectionInfo> vec;
+        utils::parseTrackConnectionAttribute(value, vec);
+    }
+}
+
+void SSPLibUtilsBenchmark::trackConnInfoToString_data()
+{
+    parseTrackConnectionAttribute_data();
+}
+
+void SSPLibUtilsBenchmark::trackConnInfoToString()
+{
+    QFETCH(QString, value);
+    QFETCH(int, count);
+
+    QList<TrackConnectionInfo> vec;
+    QVERIFY(utils::parseTrackConnectionAttribute(value, vec));
+    QCOMPARE(vec.size(), count);
+
+    //Round trip must give back same connections
+    QList<TrackConnectionInfo> roundTrip;
+    QVERIFY(utils::parseTrackConnectionAttribute(utils::trackConnInfoToString(vec), roundTrip));
+    QCOMPARE(roundTrip.size(), vec.size());
+    for(int i = 0; i < vec.size(); i++)
+    {
+        QCOMPARE(roundTrip.at(i).gateLetter, vec.at(i).gateLetter);
+        QCOMPARE(roundTrip.at(i).gateTrackPos, vec.at(i).gateTrackPos);
+        QCOMPARE(roundTrip.at(i).stationTrackPos, vec.at(i).stationTrackPos);
+    }
+
+    QBENCHMARK
+    {
+        QString str = utils::trackConnInfoToString(vec);
+        Q_UNUSED(str)
+    }
+}
+
+void SSPLibUtilsBenchmark::parseStrokeWidthStyle_data()
+{
+    QTest::addColumn<QString>("attrName");
+    QTest::addColumn<QString>("attrValue");
+    QTest::addColumn<double>("expected");
+
+    QTest::newRow("inkscape_style") << QStringLiteral("style")
+                                    << QStringLiteral("fill:none;stroke:#000000;stroke-width:0.529167;stroke-linecap:butt;"
+                                                      "stroke-linejoin:miter;stroke-miterlimit:4;stroke-dasharray:none;"
+                                                      "stroke-opacity:1")
+                                    << 0.529167;
+    QTest::newRow("optimized_style") << QStringLiteral("style")
+                                     << QStringLiteral("fill:none;stroke:#000;stroke-width:.52917")
+                                     << 0.52917;
+    QTest::newRow("attribute") << QStringLiteral("stroke-width")
+                               << QStringLiteral(" 1.0583333 ")
+                               << 1.0583333;
+}
+
+void SSPLibUtilsBenchmark::parseStrokeWidthStyle()
+{
+    QFETCH(QString, attrName);
+    QFETCH(QString, attrValue);
+    QFETCH(double, expected);
+
+    const utils::XmlElement e = makeElement(svg_tags::PathTag,
+                                            {{"d", "m 52.916667,68.791667 h 47.625003"},
+                                             {attrName, attrValue}});
+    const utils::ElementStyle parentStyle;
+    const QRectF bounds(52.916667, 68.791667, 47.625003, 0);
+
+    double val = 0;
+    QVERIFY(utils::parseStrokeWidth(e, parentStyle, bounds, val));
+    QCOMPARE(val, expected);
+
+    QBENCHMARK
+    {
+        utils::ElementStyle style = utils::parseStrokeWidthStyle(e, parentStyle, bounds);
+        Q_UNUSED(style)
+    }
+}
+
+void SSPLibUtilsBenchmark::parseTransformationMatrix_data()
+{
+    QTest::addColumn<QString>("value");
+
+    QTest::newRow("translate") << QStringLiteral("translate(-21.166667,-42.333334)");
+    QTest::newRow("matrix") << QStringLiteral("matrix(0.26458333,0,0,0.26458333,-12.5,34.2)");
+    QTest::newRow("rotate_scale") << QStringLiteral("rotate(-90) scale(0.99999998,1.0000001)");
+    QTest::newRow("chain") << QStringLiteral("translate(63.5,95.25) rotate(45,10.583333,5.2916665) "
+                                             "skewX(-12.5) scale(1.0583333)");
+}
+
+void SSPLibUtilsBenchmark::parseTransformationMatrix()
+{
+    QFETCH(QString, value);
+
+    QVERIFY(!utils::parseTransformationMatrix(value).isIdentity());
+
+    QBENCHMARK
+    {
+        QTransform t = utils::parseTransformationMatrix(value);
+        Q_UNUSED(t)
+    }
+}
+
+void SSPLibUtilsBenchmark::combineTransform_data()
+{
+    QTest::addColumn<QStringList>("chain");
+
+    //Layer, group, element as nested by Inkscape
+    QTest::newRow("layers") << QStringList{QStringLiteral("translate(-21.166667,-42.333334)"),
+                                           QStringLiteral("matrix(0.26458333,0,0,0.26458333,-12.5,34.2)"),
+                                           QStringLiteral("rotate(-90)")};
+    QTest::newRow("empty_groups") << QStringList{QString(),
+                                                 QStringLiteral("translate(10.583333,0)"),
+                                                 QString(),
+                                                 QString()};
+}
+
+void SSPLibUtilsBenchmark::combineTransform()
+{
+    QFETCH(QStringList, chain);
+
+    QBENCHMARK
+    {
+        utils::Transform t;
+        for(const QString& val : chain)
+            t = utils::combineTransform(t, val);
+    }
+}
+
+QTEST_GUILESS_MAIN(SSPLibUtilsBenchmark)
+
+#include "ssplibutilsbenchmark.moc"
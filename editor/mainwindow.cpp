@@ -5,11 +5,16 @@
 #include <QSlider>
 #include <QSpinBox>
 #include <QDockWidget>
+#include <QUndoStack>
+#include <QProgressDialog>
+#include <QPushButton>
 
 #include <QFileDialog>
 #include <QFile>
 
 #include "manager/nodefindermgr.h"
+#include "manager/nodefinderundojournal.h"
+#include "manager/nodefinderdocumentloader.h"
 
 #include <QMessageBox>
 
@@ -23,6 +28,7 @@ MainWindow::MainWindow(QWidget *parent) :
     ui->setupUi(this);
 
     nodeMgr = new NodeFinderMgr(this);
+    connect(nodeMgr, &NodeFinderMgr::svgLoaded, this, &MainWindow::onSVGLoaded);
 
     scrollArea = new QScrollArea(this);
     scrollArea->setBackgroundRole(QPalette::Dark);
@@ -51,6 +57,22 @@ MainWindow::MainWindow(QWidget *parent) :
     fileMenu->addAction(tr("Unload XML"), nodeMgr, &NodeFinderMgr::clearXML);
     ui->menubar->addMenu(fileMenu);
 
+    NodeFinderUndoJournal *journal = nodeMgr->getJournal();
+    QMenu *editMenu = new QMenu(tr("Edit"), this);
+    QAction *undoAct = editMenu->addAction(tr("Undo"), journal, &NodeFinderUndoJournal::undo);
+    undoAct->setShortcut(QKeySequence::Undo);
+    undoAct->setEnabled(false);
+    connect(journal->undoStack(), &QUndoStack::canUndoChanged, undoAct, &QAction::setEnabled);
+    QAction *redoAct = editMenu->addAction(tr("Redo"), journal, &NodeFinderUndoJournal::redo);
+    redoAct->setShortcut(QKeySequence::Redo);
+    redoAct->setEnabled(false);
+    connect(journal->undoStack(), &QUndoStack::canRedoChanged, redoAct, &QAction::setEnabled);
+    editMenu->addSeparator();
+    editMenu->addAction(tr("Suggest Tags"), nodeMgr, &NodeFinderMgr::computeSuggestions);
+    editMenu->addAction(tr("Accept All Suggestions"), nodeMgr, &NodeFinderMgr::acceptAllSuggestions);
+    editMenu->addAction(tr("Clear Suggestions"), nodeMgr, &NodeFinderMgr::clearSuggestions);
+    ui->menubar->addMenu(editMenu);
+
     QMenu *viewMenu = new QMenu(tr("View"), this);
     viewMenu->addAction(tr("Zoom In"), this, [this](){ setZoom(zoom - zoom%25 + 25); });
     viewMenu->addAction(tr("Zoom Out"), this, [this](){ setZoom(zoom - zoom%25 - 25); });
@@ -101,17 +123,72 @@ void MainWindow::loadSVG()
     if(fileName.isEmpty())
         return;
 
-    QFile f(fileName);
-    if(!f.open(QFile::ReadOnly))
+    if(nodeMgr->isLoadingSVG())
+        return;
+
+    //Read in background, manager deletes file when done
+    QFile *f = new QFile(fileName);
+    if(!f->open(QFile::ReadOnly))
     {
-        qDebug() << f.errorString();
+        qDebug() << f->errorString();
+        delete f;
         return;
     }
 
-    if(!nodeMgr->loadSVG(&f))
+    loadingFileName = fileName;
+
+    loadProgress = new QProgressDialog(this);
+    loadProgress->setAttribute(Qt::WA_DeleteOnClose);
+    loadProgress->setWindowTitle(tr("Loading SVG"));
+    loadProgress->setLabelText(NodeFinderDocumentLoader::getPhaseName(NodeFinderDocumentLoader::Phase::ParseDocument));
+    loadProgress->setWindowModality(Qt::WindowModal);
+    loadProgress->setMinimumDuration(0);
+    loadProgress->setAutoReset(false); //Each phase goes to 100%
+    loadProgress->setAutoClose(false);
+
+    NodeFinderDocumentLoader *loader = nodeMgr->getDocumentLoader();
+
+    //Dialog hides itself when canceled, so own button does not forward to it.
+    //Dialog stays until worker has stopped and is closed by onSVGLoaded()
+    QPushButton *cancelBut = new QPushButton(tr("Cancel"));
+    loadProgress->setCancelButton(cancelBut);
+    cancelBut->disconnect(loadProgress);
+    connect(cancelBut, &QPushButton::clicked, loader, &NodeFinderDocumentLoader::cancel);
+    connect(cancelBut, &QPushButton::clicked, loadProgress, [this, cancelBut]()
+            {
+                cancelBut->setEnabled(false);
+                loadProgress->setLabelText(tr("Cancelling..."));
+            });
+
+    //Closing dialog window also stops loading
+    connect(loadProgress, &QProgressDialog::canceled, loader, &NodeFinderDocumentLoader::cancel);
+    connect(loader, &NodeFinderDocumentLoader::progress, loadProgress,
+            [this, loader](int phase, int value, int max)
+            {
+                if(loader->isCancelled())
+                    return; //Keep cancelling message
+
+                loadProgress->setLabelText(NodeFinderDocumentLoader::getPhaseName(NodeFinderDocumentLoader::Phase(phase)));
+                loadProgress->setRange(0, max);
+                loadProgress->setValue(value);
+            });
+
+    if(!nodeMgr->loadSVG(f))
     {
+        loadProgress->close();
         QMessageBox::warning(this, tr("Loading Error"), tr("Could not load SVG from '%1'").arg(fileName));
     }
+}
+
+void MainWindow::onSVGLoaded(bool ok, bool cancelled)
+{
+    if(loadProgress)
+        loadProgress->close();
+
+    if(!ok && !cancelled)
+    {
+        QMessageBox::warning(this, tr("Loading Error"), tr("Could not load SVG from '%1'").arg(loadingFileName));
+    }
 
     setZoom(100);
 }
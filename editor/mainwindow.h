@@ -2,12 +2,14 @@
 #define MAINWINDOW_H
 
 #include <QMainWindow>
+#include <QPointer>
 
 QT_BEGIN_NAMESPACE
 namespace Ui { class MainWindow; }
 class QScrollArea;
 class QSlider;
 class QSpinBox;
+class QProgressDialog;
 QT_END_NAMESPACE
 
 class NodeFinderMgr;
@@ -26,6 +28,9 @@ public slots:
     void saveConvertedSVG();
     void setZoom(int val);
 
+private slots:
+    void onSVGLoaded(bool ok, bool cancelled);
+
 private:
     Ui::MainWindow *ui;
     QScrollArea *scrollArea;
@@ -34,5 +39,8 @@ private:
     int zoom;
 
     NodeFinderMgr *nodeMgr;
+
+    QPointer<QProgressDialog> loadProgress;
+    QString loadingFileName;
 };
 #endif // MAINWINDOW_H
@@ -6,6 +6,7 @@
 
 #include "nodefindermgr.h"
 #include "nodefindersvgconverter.h"
+#include "nodefinderundojournal.h"
 
 ElementSplitterHelper::ElementSplitterHelper(NodeFinderMgr *mgr, QDomElement e, double threshold) :
     nodeMgr(mgr),
@@ -17,40 +18,74 @@ ElementSplitterHelper::ElementSplitterHelper(NodeFinderMgr *mgr, QDomElement e,
 
 bool ElementSplitterHelper::splitAt(const QPointF &pos)
 {
-    QPainterPath path;
-    QPainterPath dest;
-    QPainterPath rest;
+    return splitAt(QList<QPointF>{pos});
+}
 
-    if(!ssplib::utils::convertElementToPath(origElem, path))
-        return false;
+bool ElementSplitterHelper::splitAt(const QList<QPointF> &points)
+{
+    NodeFinderSVGConverter *conv = nodeMgr->getConverter();
 
-    if(!cutPathAtPoint(pos, m_threshold, path, dest, rest))
+    ssplib::ElementPath elemPath;
+    if(!conv->getElementPath(origElem, elemPath))
         return false;
 
-    if(!convertToPath(origElem, dest, nodeMgr))
+    QList<QPainterPath> pieces;
+    if(cutPathAtPoints(points, m_threshold, elemPath.path, pieces) == 0)
         return false;
 
-    QString restVal;
-    if(!ssplib::utils::convertPathToSVG(rest, restVal))
-        return false;
+    //Convert all pieces before touching the document
+    QStringList pieceValues;
+    pieceValues.reserve(pieces.size() - 1);
+    for(int i = 1; i < pieces.size(); i++)
+    {
+        QString val;
+        if(!ssplib::utils::convertPathToSVG(pieces.at(i), val))
+            return false;
+        pieceValues.append(val);
+    }
 
-    convertToPath(origElem, dest, nodeMgr);
+    //Remember original element for undo
+    const NodeFinderElementState before = NodeFinderElementState::capture(conv, origElem);
 
-    //Copy
-    QDomElement newElem = origElem.cloneNode().toElement();
-    origElem.parentNode().insertAfter(newElem, origElem);
+    if(!convertToPath(origElem, pieces.first(), nodeMgr))
+        return false;
 
-    newElem.setAttribute("d", restVal);
+    const NodeFinderElementState after = NodeFinderElementState::capture(conv, origElem);
 
-    //Generate new ID
-    int counter = 0;
+    //Generate new IDs in path order
     const QString base = origElem.attribute(ssplib::svg_attr::ID);
-    QString id = nodeMgr->getConverter()->m_info.getFreeId_internal(base, counter);
+    QStringList newIds;
+    newIds.reserve(pieceValues.size());
+    for(int i = 0; i < pieceValues.size(); i++)
+        newIds.append(conv->m_info.generateId(base));
+
+    //Insert copies right after original element starting from last piece,
+    //so undo commands can replay each insertion in the same way
+    QList<QDomElement> newElems;
+    newElems.reserve(pieceValues.size());
+    for(int i = pieceValues.size() - 1; i >= 0; i--)
+    {
+        QDomElement newElem = origElem.cloneNode().toElement();
+        origElem.parentNode().insertAfter(newElem, origElem);
+
+        newElem.setAttribute("d", pieceValues.at(i));
+        newElem.setAttribute(ssplib::svg_attr::ID, newIds.at(i));
+        newElems.append(newElem);
+    }
 
-    newElem.setAttribute(ssplib::svg_attr::ID, id);
+    //Store new elements together
+    for(QDomElement& newElem : newElems)
+        conv->storeElement(newElem);
 
-    //Store new element
-    nodeMgr->getConverter()->storeElement(newElem);
+    //First command restores original element, others only remove their copy
+    NodeFinderUndoJournal *journal = nodeMgr->getJournal();
+    journal->beginMacro(NodeFinderUndoJournal::tr("Split Element"));
+    for(int i = 0; i < newElems.size(); i++)
+    {
+        const NodeFinderElementState newState = NodeFinderElementState::capture(conv, newElems.at(i));
+        journal->recordElementSplit(origElem, i == 0 ? before : after, after, newElems.at(i), newState);
+    }
+    journal->endMacro();
 
     return true;
 }
@@ -93,5 +128,9 @@ bool ElementSplitterHelper::convertToPath(QDomElement &e, const QPainterPath &pa
         return false;
 
     e.setAttribute("d", destVal);
+
+    //Geometry changed
+    mgr->getConverter()->invalidateGeometry(e);
+    mgr->getConverter()->updateSpatialIndex(e);
     return true;
 }
@@ -3,6 +3,7 @@
 
 #include <QDomElement>
 #include <QPointF>
+#include <QList>
 
 class QPainterPath;
 
@@ -15,6 +16,9 @@ public:
 
     bool splitAt(const QPointF& pos);
 
+    //Split in multiple pieces, cuts are calculated in one pass
+    bool splitAt(const QList<QPointF>& points);
+
     static bool convertToPath(QDomElement &e, const QPainterPath& path, NodeFinderMgr *mgr);
 
 private:
@@ -0,0 +1,184 @@
+#include "nodefinderdocumentloader.h"
+
+#include "nodefindersvgconverter.h"
+#include "nodefinderrendererloader.h"
+
+#include <ssplib/stationplan.h>
+
+#include <QIODevice>
+#include <QSvgRenderer>
+#include <QThread>
+
+#include <functional>
+
+//Forwards reads to source device and reports read position
+//Reads fail once callback returns false, this stops XML parsing
+class NodeFinderProgressDevice : public QIODevice
+{
+public:
+    typedef std::function<bool(qint64, qint64)> Callback;
+
+    NodeFinderProgressDevice(QIODevice *source, const Callback& callback) :
+        m_source(source),
+        m_callback(callback)
+    {
+
+    }
+
+    bool isSequential() const override { return true; }
+
+    qint64 bytesAvailable() const override
+    {
+        return m_source->bytesAvailable() + QIODevice::bytesAvailable();
+    }
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override
+    {
+        if(!m_callback(m_source->pos(), m_source->size()))
+            return -1;
+        return m_source->read(data, maxSize);
+    }
+
+    qint64 writeData(const char *, qint64) override
+    {
+        return -1;
+    }
+
+private:
+    QIODevice *m_source;
+    Callback m_callback;
+};
+
+NodeFinderDocumentLoader::NodeFinderDocumentLoader(NodeFinderSVGConverter *conv, QObject *parent) :
+    QObject(parent),
+    m_conv(conv),
+    m_cancelled(0),
+    m_running(false),
+    m_lastPhase(-1),
+    m_lastPercent(-1)
+{
+    //Converter data is not thread safe, one load at a time
+    m_pool.setMaxThreadCount(1);
+}
+
+NodeFinderDocumentLoader::~NodeFinderDocumentLoader()
+{
+    //Worker uses converter and posts result to this object
+    cancel();
+    m_pool.waitForDone();
+}
+
+bool NodeFinderDocumentLoader::start(QIODevice *dev)
+{
+    if(m_running)
+    {
+        delete dev;
+        return false;
+    }
+
+    m_running = true;
+    m_cancelled.storeRelaxed(0);
+    m_lastPhase = -1;
+    m_lastPercent = -1;
+
+    QThread *guiThread = thread();
+
+    m_pool.start([this, dev, guiThread]()
+    {
+        QSharedPointer<ssplib::StationPlan> plan(new ssplib::StationPlan);
+        QSharedPointer<QSvgRenderer> svg;
+
+        const bool ok = run(dev, plan.data(), svg);
+        if(svg)
+            svg->moveToThread(guiThread);
+
+        QMetaObject::invokeMethod(this, [this, dev, ok, plan, svg]()
+            {
+                onFinished(dev, ok, *plan, svg);
+            }, Qt::QueuedConnection);
+    });
+
+    return true;
+}
+
+void NodeFinderDocumentLoader::cancel()
+{
+    m_cancelled.storeRelaxed(1);
+}
+
+QString NodeFinderDocumentLoader::getPhaseName(Phase phase)
+{
+    switch (phase)
+    {
+    case Phase::ParseDocument:
+        return tr("Parsing document...");
+    case Phase::ProcessElements:
+        return tr("Processing elements...");
+    case Phase::LoadRenderer:
+        return tr("Loading view...");
+    case Phase::NPhases:
+        break;
+    }
+    return QString();
+}
+
+bool NodeFinderDocumentLoader::run(QIODevice *dev, ssplib::StationPlan *plan, QSharedPointer<QSvgRenderer> &outSvg)
+{
+    //Parse document reading through wrapper to report progress and cancel
+    NodeFinderProgressDevice progressDev(dev, [this](qint64 pos, qint64 size) -> bool
+        {
+            reportProgress(Phase::ParseDocument, pos, size);
+            return !m_cancelled.loadRelaxed();
+        });
+    progressDev.open(QIODevice::ReadOnly);
+
+    if(!m_conv->loadDocument(&progressDev) || m_cancelled.loadRelaxed())
+        return false;
+
+    //Process elements
+    auto elementProgress = [this](int processed, int total) -> bool
+    {
+        reportProgress(Phase::ProcessElements, processed, total);
+        return !m_cancelled.loadRelaxed();
+    };
+
+    if(!m_conv->processElements(plan, elementProgress) || m_cancelled.loadRelaxed())
+        return false;
+
+    //Renderer loading cannot be interrupted
+    reportProgress(Phase::LoadRenderer, 0, 0);
+
+    outSvg = NodeFinderRendererLoader::createRenderer(m_conv->mDoc);
+    return outSvg && !m_cancelled.loadRelaxed();
+}
+
+void NodeFinderDocumentLoader::reportProgress(Phase phase, qint64 value, qint64 max)
+{
+    const int percent = max > 0 ? int(qBound(qint64(0), value * 100 / max, qint64(100))) : 0;
+    if(int(phase) == m_lastPhase && percent == m_lastPercent)
+        return;
+
+    m_lastPhase = int(phase);
+    m_lastPercent = percent;
+
+    //Queued to GUI thread
+    emit progress(int(phase), percent, max > 0 ? 100 : 0);
+}
+
+void NodeFinderDocumentLoader::onFinished(QIODevice *dev, bool ok, const ssplib::StationPlan &plan, QSharedPointer<QSvgRenderer> svg)
+{
+    delete dev;
+    m_running = false;
+
+    const bool cancelled = m_cancelled.loadRelaxed();
+    ok = ok && !cancelled;
+
+    if(ok)
+    {
+        m_conv->setProcessedPlan(plan);
+        m_conv->getRendererLoader()->setLoadedRenderer(svg);
+    }
+
+    emit finished(ok, cancelled);
+}
@@ -0,0 +1,74 @@
+#ifndef NODEFINDERDOCUMENTLOADER_H
+#define NODEFINDERDOCUMENTLOADER_H
+
+#include <QObject>
+#include <QThreadPool>
+#include <QAtomicInteger>
+#include <QSharedPointer>
+
+class QIODevice;
+class QSvgRenderer;
+
+namespace ssplib {
+class StationPlan;
+} // namespace ssplib
+
+class NodeFinderSVGConverter;
+
+//Loads SVG document in a worker thread
+//Document parsing, element processing and renderer loading run in order.
+//Converter document and element registry must not be used until finished(),
+//station plan is parsed separately so views can keep drawing the current one.
+class NodeFinderDocumentLoader : public QObject
+{
+    Q_OBJECT
+public:
+    enum class Phase
+    {
+        ParseDocument = 0,
+        ProcessElements,
+        LoadRenderer,
+        NPhases
+    };
+
+    explicit NodeFinderDocumentLoader(NodeFinderSVGConverter *conv, QObject *parent = nullptr);
+    ~NodeFinderDocumentLoader();
+
+    //Takes ownership of device, it's deleted when loading ends
+    bool start(QIODevice *dev);
+
+    //Can be called from any thread, finished() is still emitted
+    //once worker has stopped, renderer loading cannot be interrupted
+    void cancel();
+
+    inline bool isRunning() const { return m_running; }
+    inline bool isCancelled() const { return m_cancelled.loadRelaxed(); }
+
+    static QString getPhaseName(Phase phase);
+
+signals:
+    //Emitted from worker thread, max is 0 if unknown
+    void progress(int phase, int value, int max);
+
+    void finished(bool ok, bool cancelled);
+
+private:
+    bool run(QIODevice *dev, ssplib::StationPlan *plan, QSharedPointer<QSvgRenderer> &outSvg);
+    void reportProgress(Phase phase, qint64 value, qint64 max);
+
+    void onFinished(QIODevice *dev, bool ok, const ssplib::StationPlan& plan, QSharedPointer<QSvgRenderer> svg);
+
+private:
+    NodeFinderSVGConverter *m_conv;
+
+    QThreadPool m_pool;
+
+    QAtomicInteger<int> m_cancelled;
+    bool m_running;
+
+    //Last reported value, avoids flooding GUI thread, used by worker only
+    int m_lastPhase;
+    int m_lastPercent;
+};
+
+#endif // NODEFINDERDOCUMENTLOADER_H
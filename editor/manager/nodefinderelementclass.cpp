@@ -4,10 +4,10 @@
 
 #include <ssplib/utils/svg_constants.h>
 
-NodeFinderElementClass::NodeFinderElementClass(const QString &tag, const QString &baseId) :
+NodeFinderElementClass::NodeFinderElementClass(int tagId, const QString &tag, const QString &baseId) :
     tagName(tag),
     m_baseId(baseId),
-    serial(0)
+    m_tagId(tagId)
 {
 
 }
@@ -29,19 +29,17 @@ bool NodeFinderElementClass::preocessElement(QDomElement e, NodeFinderSVGConvert
         //element's bounds from Qt SVG renderer.
         //When saving this ID will be removed.
 
-        id = conv->m_info.getFreeId_internal(m_baseId, serial);
+        id = conv->m_info.generateId(m_baseId);
 
-        if(!id.isEmpty())
-        {
-            //Remember the generated ID to remove it later
-            e.setAttribute(ssplib::svg_attr::ID, id);
-            conv->fakeIds.insert(id, e);
-        }
+        //Remember the generated ID to remove it later
+        e.setAttribute(ssplib::svg_attr::ID, id);
+        conv->fakeIds.insert(id, e);
     }
 
-    if(!id.isEmpty())
+    if(!id.isEmpty() && !indexById.contains(id))
     {
-        elements.insert(id, e);
+        indexById.insert(id, elements.size());
+        elements.append(e);
     }
 
     return true;
@@ -49,8 +47,8 @@ bool NodeFinderElementClass::preocessElement(QDomElement e, NodeFinderSVGConvert
 
 void NodeFinderElementClass::clear()
 {
-    serial = 0;
     elements.clear();
+    indexById.clear();
 }
 
 void NodeFinderElementClass::renameElement(QDomElement &e, const QString& newId, NodeFinderSVGConverter *conv)
@@ -60,23 +58,39 @@ void NodeFinderElementClass::renameElement(QDomElement &e, const QString& newId,
     //Remove from fake and do not insert back, because now it is used
     conv->fakeIds.remove(oldId);
     conv->m_info.namedElements.remove(oldId);
-    elements.remove(oldId);
+    const int idx = indexById.value(oldId, -1);
+    indexById.remove(oldId);
 
     if(newId.isEmpty())
     {
-        //No new ID
+        //No new ID, element cannot be queried anymore
         e.removeAttribute(ssplib::svg_attr::ID);
+        if(idx >= 0)
+            elements[idx] = QDomElement();
     }
     else
     {
         e.setAttribute(ssplib::svg_attr::ID, newId);
-        elements.insert(newId, e);
+        if(idx >= 0)
+        {
+            //Keep same slot
+            indexById.insert(newId, idx);
+        }
+        else
+        {
+            indexById.insert(newId, elements.size());
+            elements.append(e);
+        }
         conv->m_info.namedElements.insert(newId, e);
+        conv->m_info.reserveId(newId);
     }
 }
 
 void NodeFinderElementClass::removeElement(QDomElement &e)
 {
     const QString oldId = e.attribute(ssplib::svg_attr::ID);
-    elements.remove(oldId);
+    const int idx = indexById.value(oldId, -1);
+    indexById.remove(oldId);
+    if(idx >= 0)
+        elements[idx] = QDomElement();
 }
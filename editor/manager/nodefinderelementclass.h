@@ -3,19 +3,23 @@
 
 #include <QString>
 #include <QDomElement>
-#include <QMap>
+#include <QHash>
+#include <QList>
 
 class NodeFinderSVGConverter;
 
+//Elements of a single tag, stored in document order
+//Removed elements leave a null slot so walker indices stay valid
 class NodeFinderElementClass
 {
 public:
     typedef QHash<QString, QDomElement> ElementHash;
-    typedef QMap<QString, QDomElement> ElementMap;
+    typedef QList<QDomElement> ElementList;
 
-    NodeFinderElementClass(const QString& tag, const QString& baseId);
+    NodeFinderElementClass(int tagId, const QString& tag, const QString& baseId);
 
     QString getTagName() const;
+    inline int getTagId() const { return m_tagId; }
 
     bool preocessElement(QDomElement e, NodeFinderSVGConverter *conv);
 
@@ -23,10 +27,10 @@ public:
 
     inline bool getElementById(const QString& id, QDomElement &e) const
     {
-        auto it = elements.constFind(id);
-        if(it == elements.constEnd())
+        const int idx = indexById.value(id, -1);
+        if(idx < 0)
             return false;
-        e = it.value();
+        e = elements.at(idx);
         return true;
     }
 
@@ -34,13 +38,21 @@ public:
 
     void removeElement(QDomElement &e);
 
+    inline int indexOf(const QString& id) const { return indexById.value(id, -1); }
+
+    //Number of slots, including removed ones
+    inline int count() const { return elements.size(); }
+
+    //Returns null element if it was removed
+    inline QDomElement elementAt(int idx) const { return elements.at(idx); }
+
 private:
     QString tagName;
     QString m_baseId;
-    int serial;
+    int m_tagId;
 
-    friend class NodeFinderElementWalker;
-    ElementMap elements;
+    ElementList elements;
+    QHash<QString, int> indexById;
 };
 
 #endif // NODEFINDERELEMENTCLASS_H
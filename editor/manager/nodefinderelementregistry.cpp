@@ -0,0 +1,32 @@
+#include "nodefinderelementregistry.h"
+
+int NodeFinderElementRegistry::registerClass(const QString &tagName, const QString &baseId)
+{
+    int id = tagId(tagName);
+    if(id >= 0)
+        return id;
+
+    id = m_classes.size();
+    m_classes.append(NodeFinderElementClass(id, tagName, baseId));
+    m_tagIds.insert(tagName, id);
+    return id;
+}
+
+QList<int> NodeFinderElementRegistry::tagIdsFor(const QStringList &tags) const
+{
+    QList<int> ids;
+    ids.reserve(tags.size());
+    for(const QString& tag : tags)
+    {
+        const int id = tagId(tag);
+        if(id >= 0)
+            ids.append(id);
+    }
+    return ids;
+}
+
+void NodeFinderElementRegistry::clearElements()
+{
+    for(NodeFinderElementClass &c : m_classes)
+        c.clear();
+}
@@ -0,0 +1,42 @@
+#ifndef NODEFINDERELEMENTREGISTRY_H
+#define NODEFINDERELEMENTREGISTRY_H
+
+#include "nodefinderelementclass.h"
+
+#include <QStringList>
+
+//Table of registered element classes indexed by interned tag id
+class NodeFinderElementRegistry
+{
+public:
+    NodeFinderElementRegistry() = default;
+
+    //Returns tag id of new or already registered class
+    int registerClass(const QString& tagName, const QString& baseId);
+
+    inline int tagId(const QString& tagName) const { return m_tagIds.value(tagName, -1); }
+
+    //Skips unregistered tags
+    QList<int> tagIdsFor(const QStringList& tags) const;
+
+    inline int classCount() const { return m_classes.size(); }
+    inline const NodeFinderElementClass& classAt(int id) const { return m_classes.at(id); }
+
+    //Returns nullptr if tag is not registered
+    inline NodeFinderElementClass *classForTag(const QString& tagName)
+    {
+        const int id = tagId(tagName);
+        if(id < 0)
+            return nullptr;
+        return &m_classes[id];
+    }
+
+    //Remove elements but keep registered classes
+    void clearElements();
+
+private:
+    QHash<QString, int> m_tagIds;
+    QList<NodeFinderElementClass> m_classes;
+};
+
+#endif // NODEFINDERELEMENTREGISTRY_H
@@ -1,86 +1,170 @@
 #include "nodefinderelementwalker.h"
 
-NodeFinderElementWalker::NodeFinderElementWalker(const QStringList &orderedTags,
-                                                 const QHash<QString, NodeFinderElementClass> &elementClasses) :
-    m_orderedTags(orderedTags),
-    m_elementClasses(elementClasses)
+#include "nodefinderelementregistry.h"
+
+#include <limits>
+
+//Position after last element of current tag
+static constexpr int AfterLastElement = std::numeric_limits<int>::max();
+
+NodeFinderElementWalker::NodeFinderElementWalker(const QList<int> &tagOrder,
+                                                 const NodeFinderElementRegistry *registry) :
+    m_registry(registry),
+    m_tagOrder(tagOrder)
+{
+
+}
+
+NodeFinderElementWalker::NodeFinderElementWalker(const QList<NodeFinderSpatialIndex::Entry> &candidates,
+                                                 const NodeFinderElementRegistry *registry) :
+    m_registry(registry),
+    m_candidates(candidates),
+    m_useCandidates(true)
 {
 
 }
 
 bool NodeFinderElementWalker::next()
 {
-    if(m_status.currentMap)
-        m_status.iter++;
+    if(!m_registry)
+        return false;
 
-    while(!m_status.currentMap || m_status.iter == m_status.currentMap->end())
+    if(m_useCandidates)
+        return nextCandidate();
+
+    const int tagCount = m_tagOrder.size();
+
+    if(m_status.tagIdx < 0)
     {
-        //Go to next class
-        m_status.tagIdx++;
-        m_status.currentMap = nullptr;
+        m_status.tagIdx = 0;
+        m_status.elemIdx = -1;
+    }
 
-        if(m_status.tagIdx >= m_orderedTags.count())
+    while(m_status.tagIdx < tagCount)
+    {
+        const NodeFinderElementClass& c = m_registry->classAt(m_tagOrder.at(m_status.tagIdx));
+        for(int i = m_status.elemIdx + 1; i < c.count(); i++)
         {
-            m_status.tagIdx = m_orderedTags.count();
-            if(m_status.tagIdx == 0)
-                m_status.tagIdx = -1;
-            return false; //It was last class
-        }
+            if(c.elementAt(i).isNull())
+                continue; //Skip removed elements
 
-        const QString tag = m_orderedTags.at(m_status.tagIdx);
-        auto it = m_elementClasses.find(tag);
-        if(it == m_elementClasses.end() || it.value().elements.isEmpty())
-            continue; //Skip tag
-
-        m_status.currentMap = &it.value().elements;
-        m_status.iter = m_status.currentMap->begin();
+            m_status.elemIdx = i;
+            return true;
+        }
 
-        return true;
+        //Go to next class
+        m_status.tagIdx++;
+        m_status.elemIdx = -1;
     }
 
-    return m_status.currentMap != nullptr;
+    //It was last class
+    m_status.tagIdx = tagCount;
+    if(m_status.tagIdx == 0)
+        m_status.tagIdx = -1;
+    m_status.elemIdx = -1;
+    return false;
 }
 
 bool NodeFinderElementWalker::prev()
 {
-    while(!m_status.currentMap || m_status.iter == m_status.currentMap->begin())
+    if(!m_registry)
+        return false;
+
+    if(m_useCandidates)
+        return prevCandidate();
+
+    const int tagCount = m_tagOrder.size();
+
+    if(m_status.tagIdx >= tagCount)
     {
-        //Go to previous class
-        m_status.tagIdx--;
-        m_status.currentMap = nullptr;
+        m_status.tagIdx = tagCount - 1;
+        m_status.elemIdx = AfterLastElement;
+    }
 
-        if(m_status.tagIdx < 0)
+    while(m_status.tagIdx >= 0)
+    {
+        const NodeFinderElementClass& c = m_registry->classAt(m_tagOrder.at(m_status.tagIdx));
+        const int start = m_status.elemIdx == AfterLastElement ? c.count() : m_status.elemIdx;
+        for(int i = start - 1; i >= 0; i--)
         {
-            m_status.tagIdx = -1;
-            return false; //It was first class
-        }
-
-        const QString tag = m_orderedTags.at(m_status.tagIdx);
-        auto it = m_elementClasses.find(tag);
-        if(it == m_elementClasses.end() || it.value().elements.isEmpty())
-            continue; //Skip tag
+            if(c.elementAt(i).isNull())
+                continue; //Skip removed elements
 
-        m_status.currentMap = &it.value().elements;
-        m_status.iter = std::prev(m_status.currentMap->end());
+            m_status.elemIdx = i;
+            return true;
+        }
 
-        return true;
+        //Go to previous class
+        m_status.tagIdx--;
+        m_status.elemIdx = AfterLastElement;
     }
 
-    if(m_status.currentMap)
-        m_status.iter--;
-
-    return m_status.currentMap != nullptr;
+    //It was first class
+    m_status.tagIdx = -1;
+    m_status.elemIdx = -1;
+    return false;
 }
 
 bool NodeFinderElementWalker::isValid() const
 {
-    return m_status.currentMap != nullptr;
+    if(!m_registry)
+        return false;
+
+    if(m_useCandidates)
+        return m_status.elemIdx >= 0 && m_status.elemIdx < m_candidates.size();
+
+    if(m_status.tagIdx < 0 || m_status.tagIdx >= m_tagOrder.size())
+        return false;
+
+    const NodeFinderElementClass& c = m_registry->classAt(m_tagOrder.at(m_status.tagIdx));
+    return m_status.elemIdx >= 0 && m_status.elemIdx < c.count();
 }
 
 QDomElement NodeFinderElementWalker::element()
 {
-    if(!m_status.currentMap)
+    if(!isValid())
         return QDomElement();
 
-    return m_status.iter.value();
+    if(m_useCandidates)
+    {
+        const NodeFinderSpatialIndex::Entry& entry = m_candidates.at(m_status.elemIdx);
+        return m_registry->classAt(entry.tagId).elementAt(entry.elemIdx);
+    }
+
+    const NodeFinderElementClass& c = m_registry->classAt(m_tagOrder.at(m_status.tagIdx));
+    return c.elementAt(m_status.elemIdx);
+}
+
+bool NodeFinderElementWalker::nextCandidate()
+{
+    for(int i = qMax(m_status.elemIdx + 1, 0); i < m_candidates.size(); i++)
+    {
+        const NodeFinderSpatialIndex::Entry& entry = m_candidates.at(i);
+        if(m_registry->classAt(entry.tagId).elementAt(entry.elemIdx).isNull())
+            continue; //Skip removed elements
+
+        m_status.elemIdx = i;
+        return true;
+    }
+
+    //Past last candidate
+    m_status.elemIdx = m_candidates.size();
+    return false;
+}
+
+bool NodeFinderElementWalker::prevCandidate()
+{
+    for(int i = qMin(m_status.elemIdx, int(m_candidates.size())) - 1; i >= 0; i--)
+    {
+        const NodeFinderSpatialIndex::Entry& entry = m_candidates.at(i);
+        if(m_registry->classAt(entry.tagId).elementAt(entry.elemIdx).isNull())
+            continue; //Skip removed elements
+
+        m_status.elemIdx = i;
+        return true;
+    }
+
+    //Before first candidate
+    m_status.elemIdx = -1;
+    return false;
 }
@@ -1,14 +1,23 @@
 #ifndef NODEFINDERELEMENTWALKER_H
 #define NODEFINDERELEMENTWALKER_H
 
-#include "nodefinderelementclass.h"
-#include <QHash>
+#include <QDomElement>
+#include <QList>
 
+#include "nodefinderspatialindex.h"
+
+class NodeFinderElementRegistry;
+
+//Cursor over registry elements, following given tag order
+//or a list of candidates returned by spatial index.
+//Registry is not copied so walker must be reset when registry is cleared
 class NodeFinderElementWalker
 {
 private:
     friend class NodeFinderSVGConverter;
-    NodeFinderElementWalker(const QStringList& orderedTags, const QHash<QString, NodeFinderElementClass>& elementClasses);
+    NodeFinderElementWalker(const QList<int>& tagOrder, const NodeFinderElementRegistry *registry);
+    NodeFinderElementWalker(const QList<NodeFinderSpatialIndex::Entry>& candidates,
+                            const NodeFinderElementRegistry *registry);
 
 public:
     inline NodeFinderElementWalker() = default;
@@ -19,19 +28,25 @@ public:
 
     QDomElement element();
 
+    //In candidate mode only elemIdx is used, as candidate index
     typedef struct Status
     {
-        NodeFinderElementClass::ElementMap *currentMap = nullptr;
-        NodeFinderElementClass::ElementMap::iterator iter;
         int tagIdx = -1;
+        int elemIdx = -1;
     } Status;
 
     inline Status getStatus() const { return m_status; }
     inline void restoreStatus(const Status& s) { m_status = s; }
 
 private:
-    QStringList m_orderedTags;
-    QHash<QString, NodeFinderElementClass> m_elementClasses;
+    bool nextCandidate();
+    bool prevCandidate();
+
+private:
+    const NodeFinderElementRegistry *m_registry = nullptr;
+    QList<int> m_tagOrder;
+    QList<NodeFinderSpatialIndex::Entry> m_candidates;
+    bool m_useCandidates = false;
     Status m_status;
 };
 
@@ -0,0 +1,60 @@
+#include "nodefindergeometrycache.h"
+
+#include <ssplib/utils/svg_path_utils.h>
+#include <ssplib/utils/svg_constants.h>
+
+bool NodeFinderGeometryCache::get(const QDomElement &e, Geometry &out)
+{
+    const QString id = e.attribute(ssplib::svg_attr::ID);
+    if(id.isEmpty())
+    {
+        //Cannot be cached
+        out = calcGeometry(e);
+        return out.isValid;
+    }
+
+    auto it = m_cache.constFind(id);
+    if(it == m_cache.constEnd())
+        it = m_cache.insert(id, calcGeometry(e));
+
+    out = it.value();
+    return out.isValid;
+}
+
+void NodeFinderGeometryCache::invalidate(const QDomElement &e, bool recursive)
+{
+    invalidateId(e.attribute(ssplib::svg_attr::ID));
+
+    if(!recursive)
+        return;
+
+    for(QDomElement child = e.firstChildElement(); !child.isNull(); child = child.nextSiblingElement())
+        invalidate(child, true);
+}
+
+void NodeFinderGeometryCache::invalidateId(const QString &id)
+{
+    if(!id.isEmpty())
+        m_cache.remove(id);
+}
+
+void NodeFinderGeometryCache::clear()
+{
+    m_cache.clear();
+    m_cache.squeeze();
+}
+
+NodeFinderGeometryCache::Geometry NodeFinderGeometryCache::calcGeometry(QDomElement e)
+{
+    Geometry geom;
+    if(!ssplib::utils::convertElementToPath(e, geom.path))
+        return geom;
+
+    geom.isValid = true;
+    geom.bounds = geom.path.boundingRect();
+
+    if(!ssplib::utils::parseStrokeWidthRecursve(e, geom.bounds, geom.strokeWidth))
+        geom.strokeWidth = 0;
+
+    return geom;
+}
@@ -0,0 +1,40 @@
+#ifndef NODEFINDERGEOMETRYCACHE_H
+#define NODEFINDERGEOMETRYCACHE_H
+
+#include <QDomElement>
+#include <QPainterPath>
+#include <QHash>
+
+//Path, bounds and resolved stroke width of elements, keyed by element id
+//Stroke width depends on ancestor styles, so changing an ancestor
+//must invalidate its whole subtree.
+class NodeFinderGeometryCache
+{
+public:
+    struct Geometry
+    {
+        QPainterPath path;
+        QRectF bounds;
+        double strokeWidth = 0;
+        bool isValid = false; //False if element cannot be converted to path
+    };
+
+    //Returns false if element cannot be converted to path
+    bool get(const QDomElement& e, Geometry &out);
+
+    //Call when element style, transform or geometry changes
+    void invalidate(const QDomElement& e, bool recursive = false);
+    void invalidateId(const QString& id);
+
+    void clear();
+
+    inline int count() const { return m_cache.size(); }
+
+private:
+    static Geometry calcGeometry(QDomElement e);
+
+private:
+    QHash<QString, Geometry> m_cache;
+};
+
+#endif // NODEFINDERGEOMETRYCACHE_H
@@ -5,6 +5,11 @@
 #include "view/nodefinderdockwidget.h"
 
 #include "nodefindersvgconverter.h"
+#include "nodefinderrendererloader.h"
+#include "nodefinderdocumentloader.h"
+#include "nodefinderundojournal.h"
+#include "nodefindersuggestionengine.h"
+#include "nodefinderselectionpreview.h"
 
 #include <QSvgRenderer>
 #include <ssplib/utils/svg_path_utils.h>
@@ -13,19 +18,56 @@
 #include "elementsplitterhelper.h"
 
 #include <QMessageBox>
+#include <QUndoStack>
 
 #include "model/iobjectmodel.h"
 
 NodeFinderMgr::NodeFinderMgr(QObject *parent) :
     QObject(parent),
+    m_curSuggestion(-1),
+    m_suggestionsActive(false),
+    m_applyingSuggestions(false),
     m_isSelecting(false),
     m_isSinglePoint(false)
 {
+    //Converter models use it, create first
+    repaintScheduler = new NodeFinderRepaintScheduler(this);
+    connect(repaintScheduler, &NodeFinderRepaintScheduler::contentRepaintRequested, this, &NodeFinderMgr::repaintSVG);
+    connect(repaintScheduler, &NodeFinderRepaintScheduler::selectionRepaintRequested, this, &NodeFinderMgr::repaintSelection);
+    connect(repaintScheduler, &NodeFinderRepaintScheduler::modeRefreshRequested, this, &NodeFinderMgr::modeChanged);
+
     converter = new NodeFinderSVGConverter(this);
+    journal = new NodeFinderUndoJournal(this, converter);
+    suggestionEngine = new NodeFinderSuggestionEngine(converter);
+    selectionPreview = new NodeFinderSelectionPreview(converter);
+
+    documentLoader = new NodeFinderDocumentLoader(converter, this);
+    connect(documentLoader, &NodeFinderDocumentLoader::finished, this, &NodeFinderMgr::onDocumentLoaded);
+
+    //Manual corrections invalidate suggestions
+    connect(journal->undoStack(), &QUndoStack::indexChanged, this, [this]()
+            {
+                if(m_suggestionsActive && !m_applyingSuggestions)
+                    refreshSuggestions();
+            });
 
     setMode(EditingModes::NoEditing);
 }
 
+NodeFinderMgr::~NodeFinderMgr()
+{
+    //Load worker uses converter, which is deleted before loader as child
+    //Destructor cancels and waits for worker, do it before any teardown
+    delete documentLoader;
+    documentLoader = nullptr;
+
+    delete selectionPreview;
+    selectionPreview = nullptr;
+
+    delete suggestionEngine;
+    suggestionEngine = nullptr;
+}
+
 EditingModes NodeFinderMgr::mode() const
 {
     return m_mode;
@@ -49,28 +91,25 @@ void NodeFinderMgr::setMode(EditingModes m, EditingSubModes sub)
 
     m_subMode = sub;
 
+    if(m_subMode != EditingSubModes::DoSplitItem)
+        m_splitPoints.clear();
+
     //Draw only when not editing
     auto plan = getStationPlan();
     plan->drawLabels = plan->drawTracks = m_subMode == EditingSubModes::NotEditingCurrentItem;
 
-    emit modeChanged();
-    emit repaintSVG();
+    requestRepaint(NodeFinderRepaintScheduler::Mode | NodeFinderRepaintScheduler::Background);
 }
 
 bool NodeFinderMgr::validateCurrentElement()
 {
-    constexpr const qreal MinStrokeWidth = 5;
+    constexpr const qreal MinStrokeWidth = NodeFinderSVGConverter::MinStrokeWidth;
 
     ssplib::ElementPath elemPath;
-    elemPath.elem = converter->currentWalker.element();
-    if(!ssplib::utils::convertElementToPath(elemPath.elem, elemPath.path))
+    QRectF bounds;
+    if(!converter->getElementPath(converter->currentWalker.element(), elemPath, &bounds))
         return false; //Canmot be converted to path, skip it.
 
-    elemPath.strokeWidth = 0;
-    QRectF bounds = elemPath.path.boundingRect();
-    if(!ssplib::utils::parseStrokeWidthRecursve(elemPath.elem, bounds, elemPath.strokeWidth))
-        elemPath.strokeWidth = 0;
-
     //Null rect breaks QRectF::contains() which returns always false
     if(bounds.width() == 0)
         bounds.setWidth(1);
@@ -118,6 +157,9 @@ QString NodeFinderMgr::getModeName(EditingModes mode) const
     case EditingModes::NoSVGLoaded:
         modeName = tr("No SVG");
         break;
+    case EditingModes::LoadingSVG:
+        modeName = tr("Loading SVG");
+        break;
     case EditingModes::NoEditing:
         modeName = tr("No Editing");
         break;
@@ -158,7 +200,14 @@ QWidget *NodeFinderMgr::getCentralWidget(QWidget *parent)
     //Create a new one
     NodeFinderSVGWidget *w = new NodeFinderSVGWidget(getStationPlan(), this, parent);
     w->setRenderer(converter->renderer());
-    connect(this, &NodeFinderMgr::repaintSVG, w, QOverload<>::of(&QWidget::update));
+    connect(this, &NodeFinderMgr::repaintSVG, w, &NodeFinderSVGWidget::invalidateContent);
+    connect(this, &NodeFinderMgr::repaintSelection, w, QOverload<>::of(&QWidget::update));
+    connect(converter->getRendererLoader(), &NodeFinderRendererLoader::rendererChanged, w,
+            [w](QSvgRenderer *svg)
+            {
+                w->setRenderer(svg);
+                w->invalidateContent();
+            });
 
     centralWidget = w;
     return centralWidget;
@@ -191,35 +240,67 @@ int NodeFinderMgr::getTrackPenWidth() const
 
 bool NodeFinderMgr::loadSVG(QIODevice *dev)
 {
+    if(isLoadingSVG())
+    {
+        delete dev;
+        return false;
+    }
+
     clearCurrentItem();
 
-    bool ret = converter->loadDocument(dev);
-    if(!ret)
+    //Suggestions and history refer to old document
+    clearSuggestions();
+    journal->clear();
+
+    //Converter is used by worker until loaded, views show empty plan
+    converter->getRendererLoader()->cancelReload();
+    converter->clear();
+    setMode(EditingModes::LoadingSVG);
+
+    return documentLoader->start(dev);
+}
+
+void NodeFinderMgr::onDocumentLoaded(bool ok, bool cancelled)
+{
+    if(!ok)
     {
+        //Partially loaded document is discarded
         converter->clear();
+        converter->reloadSVGRenderer();
         setMode(EditingModes::NoSVGLoaded);
+        emit svgLoaded(false, cancelled);
+        return;
     }
 
-    //Convert SVG
-    converter->processElements();
-
-    //Load view
-    converter->reloadSVGRenderer();
-
     setTrackPenWidth(converter->calcDefaultTrackPenWidth());
 
     setMode(EditingModes::NoEditing);
-    return true;
+    emit svgLoaded(true, false);
 }
 
 bool NodeFinderMgr::saveSVG(QIODevice *dev)
 {
+    if(isLoadingSVG())
+        return false;
+
     return converter->save(dev);
 }
 
 bool NodeFinderMgr::loadXML(QIODevice *dev)
 {
-    return converter->loadXML(dev);
+    if(isLoadingSVG())
+        return false;
+
+    //Items are merged and rows change
+    clearCurrentItem();
+    journal->clear();
+
+    const bool ret = converter->loadXML(dev);
+
+    if(m_suggestionsActive)
+        refreshSuggestions();
+
+    return ret;
 }
 
 void NodeFinderMgr::clearXML()
@@ -255,6 +336,7 @@ void NodeFinderMgr::selectCurrentElem()
 
         if(m_mode == EditingModes::SplitElement)
         {
+            //Now place cut points
             setMode(m_mode, EditingSubModes::DoSplitItem);
             return;
         }
@@ -298,8 +380,23 @@ void NodeFinderMgr::selectCurrentElem()
 
         converter->removeCurrentSubElementFromItem();
     }
+    else if(m_subMode == EditingSubModes::DoSplitItem)
+    {
+        if(m_splitPoints.isEmpty())
+        {
+            if(centralWidget)
+            {
+                QMessageBox::warning(centralWidget, tr("No cut points"),
+                                     tr("Click on selected element to place cut points."));
+            }
+            return;
+        }
 
-    emit repaintSVG();
+        triggerElementSplit(m_splitPoints);
+        return;
+    }
+
+    requestRepaint(NodeFinderRepaintScheduler::Overlay);
 }
 
 void NodeFinderMgr::goToPrevElem()
@@ -371,7 +468,7 @@ void NodeFinderMgr::goToPrevElem()
         }
     }
 
-    emit repaintSVG();
+    requestRepaint(NodeFinderRepaintScheduler::Overlay);
 }
 
 void NodeFinderMgr::goToNextElem()
@@ -440,7 +537,7 @@ void NodeFinderMgr::goToNextElem()
         }
     }
 
-    emit repaintSVG();
+    requestRepaint(NodeFinderRepaintScheduler::Overlay);
 }
 
 void NodeFinderMgr::requestAddSubElement()
@@ -467,6 +564,9 @@ void NodeFinderMgr::requestEndEditItem()
 
 void NodeFinderMgr::clearCurrentItem()
 {
+    if(isLoadingSVG())
+        return; //Mode is set when loading ends
+
     //requestEndEditItem();
     converter->setCurItem(nullptr);
     clearSelection();
@@ -475,6 +575,9 @@ void NodeFinderMgr::clearCurrentItem()
 
 void NodeFinderMgr::requestEditItem(ssplib::ItemBase *item, EditingModes m)
 {
+    if(isLoadingSVG())
+        return;
+
     clearSelection();
     converter->setCurItem(item);
     setMode(m, EditingSubModes::NotEditingCurrentItem);
@@ -487,66 +590,102 @@ void NodeFinderMgr::setTrackPenWidth(int value)
         return;
     plan->platformPenWidth = value;
     emit trackPenWidthChanged(plan->platformPenWidth);
-    emit repaintSVG();
+    requestRepaint(NodeFinderRepaintScheduler::Background);
 }
 
 void NodeFinderMgr::startSelection(const QPointF &p)
 {
+    if(isLoadingSVG())
+        return;
+
     if(m_subMode == EditingSubModes::DoSplitItem)
     {
-        //Use as split
-        triggerElementSplit(p);
+        //Use as cut point
+        addSplitPoint(p);
         return;
     }
 
+    if(m_mode == EditingModes::NoEditing && !getSuggestions().isEmpty())
+    {
+        //Pick suggestion to accept or reject
+        const int idx = suggestionEngine->suggestionAt(p, getTrackPenWidth());
+        if(idx >= 0)
+        {
+            m_curSuggestion = idx;
+            requestRepaint(NodeFinderRepaintScheduler::Overlay);
+            return;
+        }
+    }
+
     clearSelection();
     m_isSelecting = true;
     m_isSinglePoint = true;
     selectionStart = selectionEnd = p;
-    emit repaintSVG();
+
+    //Preview elements which would be captured
+    if(m_subMode == EditingSubModes::AddingSubElement)
+        selectionPreview->start(getSelectableTags(), selectionStart);
+
+    requestRepaint(NodeFinderRepaintScheduler::Selection);
 }
 
 void NodeFinderMgr::endOrMoveSelection(const QPointF &p, bool isEnd)
 {
     if(!m_isSelecting)
         return;
+
+    const QRectF oldRect = getSelectionRect();
     selectionEnd = p;
 
-    if(isEnd)
+    if(!isEnd)
+    {
+        //Mouse has moved so it's not a single point
+        m_isSinglePoint = false;
+
+        selectionPreview->update(getSelectionRect());
+
+        //Do not repaint whole view on each mouse move
+        emit selectionMoved(oldRect, getSelectionRect());
+        return;
+    }
+
+    m_isSelecting = false;
+    selectionPreview->clear();
+
+    if(m_subMode == EditingSubModes::AddingSubElement)
     {
-        m_isSelecting = false;
+        //Restart element selection
+        //Walk only elements near selection, nearest first
+        converter->currentWalker = converter->walkCandidates(getSelectableTags(), getSelectionRect(), selectionStart);
+        converter->curElementPath = ssplib::ElementPath(); //Reset
 
-        if(m_subMode == EditingSubModes::AddingSubElement)
+        if(m_isSinglePoint)
         {
-            //Restart element selection
-            QStringList tags{ssplib::svg_tags::PathTag, ssplib::svg_tags::LineTag, ssplib::svg_tags::PolylineTag};
-            if(m_mode == EditingModes::LabelEditing)
-                tags.prepend(ssplib::svg_tags::RectTag);
-            converter->currentWalker = converter->walkElements(tags);
-            converter->curElementPath = ssplib::ElementPath(); //Reset
-
-            if(m_isSinglePoint)
-            {
-                //Try to select first available element
-                goToNextElem();
-            }
+            //Try to select first available element
+            goToNextElem();
         }
-    }else{
-        //Mouse has moved so it's not a single point
-        m_isSinglePoint = false;
     }
 
-    emit repaintSVG();
+    requestRepaint(NodeFinderRepaintScheduler::Selection | NodeFinderRepaintScheduler::Overlay);
 }
 
 void NodeFinderMgr::clearSelection()
 {
     m_isSelecting = false;
     m_isSinglePoint = false;
+    selectionPreview->clear();
     selectionStart = selectionEnd = QPointF();
     converter->currentWalker = NodeFinderElementWalker(); //Reset
     converter->curElementPath = ssplib::ElementPath();
-    emit repaintSVG();
+    requestRepaint(NodeFinderRepaintScheduler::Selection | NodeFinderRepaintScheduler::Overlay);
+}
+
+QStringList NodeFinderMgr::getSelectableTags() const
+{
+    QStringList tags{ssplib::svg_tags::PathTag, ssplib::svg_tags::LineTag, ssplib::svg_tags::PolylineTag};
+    if(m_mode == EditingModes::LabelEditing)
+        tags.prepend(ssplib::svg_tags::RectTag);
+    return tags;
 }
 
 void NodeFinderMgr::startElementSplitProcess()
@@ -555,16 +694,161 @@ void NodeFinderMgr::startElementSplitProcess()
     setMode(EditingModes::SplitElement, EditingSubModes::AddingSubElement);
 }
 
-void NodeFinderMgr::triggerElementSplit(const QPointF& pos)
+const QList<NodeFinderSuggestion> &NodeFinderMgr::getSuggestions() const
+{
+    return suggestionEngine->suggestions();
+}
+
+void NodeFinderMgr::computeSuggestions()
+{
+    if(isLoadingSVG())
+        return;
+
+    clearCurrentItem();
+
+    //Allow rejected suggestions again on explicit request
+    suggestionEngine->clearRejected();
+
+    m_suggestionsActive = true;
+    refreshSuggestions();
+}
+
+void NodeFinderMgr::acceptCurrentSuggestion()
+{
+    if(m_curSuggestion < 0 || m_curSuggestion >= getSuggestions().size())
+        return;
+
+    const NodeFinderSuggestion s = getSuggestions().at(m_curSuggestion);
+
+    clearCurrentItem();
+
+    m_applyingSuggestions = true;
+    journal->beginMacro(tr("Accept Suggestion"));
+    applySuggestion(s);
+    journal->endMacro();
+    m_applyingSuggestions = false;
+
+    refreshSuggestions();
+}
+
+void NodeFinderMgr::rejectCurrentSuggestion()
+{
+    if(m_curSuggestion < 0)
+        return;
+
+    suggestionEngine->reject(m_curSuggestion);
+    m_curSuggestion = -1;
+    requestRepaint(NodeFinderRepaintScheduler::Overlay);
+}
+
+void NodeFinderMgr::acceptAllSuggestions()
+{
+    if(getSuggestions().isEmpty())
+        return;
+
+    const QList<NodeFinderSuggestion> suggestions = getSuggestions();
+
+    clearCurrentItem();
+
+    m_applyingSuggestions = true;
+    journal->beginMacro(tr("Accept All Suggestions"));
+    for(const NodeFinderSuggestion& s : suggestions)
+        applySuggestion(s);
+    journal->endMacro();
+    m_applyingSuggestions = false;
+
+    refreshSuggestions();
+}
+
+void NodeFinderMgr::clearSuggestions()
+{
+    suggestionEngine->clear();
+    m_curSuggestion = -1;
+    m_suggestionsActive = false;
+    requestRepaint(NodeFinderRepaintScheduler::Overlay);
+}
+
+bool NodeFinderMgr::applySuggestion(const NodeFinderSuggestion &s)
+{
+    ssplib::StationPlan *plan = getStationPlan();
+
+    if(s.type == NodeFinderSuggestion::Type::TrackPos)
+    {
+        IObjectModel *model = converter->getModel(EditingModes::StationTrackEditing);
+
+        int row = -1;
+        for(int i = 0; i < plan->platforms.size(); i++)
+        {
+            if(plan->platforms.at(i).trackPos == s.trackPos)
+            {
+                row = i;
+                break;
+            }
+        }
+        if(row < 0)
+            return false;
+
+        for(ssplib::ElementPath p : s.elements)
+            model->addElementToItem(p, &plan->platforms[row]);
+        return true;
+    }
+
+    IObjectModel *model = converter->getModel(EditingModes::TrackPathEditing);
+
+    int row = -1;
+    for(int i = 0; i < plan->trackConnections.size(); i++)
+    {
+        if(plan->trackConnections.at(i).info.matchNames(s.connInfo))
+        {
+            row = i;
+            break;
+        }
+    }
+
+    if(row < 0)
+    {
+        //Create connection at end like NodeFinderTurnoutModel::addItem()
+        ssplib::TrackConnectionItem item;
+        item.info = s.connInfo;
+        item.visible = false;
+
+        row = plan->trackConnections.size();
+        journal->insertItem(model, &plan->trackConnections, row, item);
+    }
+
+    for(ssplib::ElementPath p : s.elements)
+        model->addElementToItem(p, &plan->trackConnections[row]);
+    return true;
+}
+
+void NodeFinderMgr::refreshSuggestions()
+{
+    //Whole drawing in one pass, fast enough to run after each change
+    suggestionEngine->compute(getStationPlan(), getTrackPenWidth());
+    m_curSuggestion = -1;
+    requestRepaint(NodeFinderRepaintScheduler::Overlay);
+}
+
+void NodeFinderMgr::addSplitPoint(const QPointF &pos)
+{
+    if(m_subMode != EditingSubModes::DoSplitItem)
+        return;
+
+    m_splitPoints.append(pos);
+    requestRepaint(NodeFinderRepaintScheduler::Overlay);
+}
+
+void NodeFinderMgr::triggerElementSplit(const QList<QPointF> &points)
 {
     int ret = QMessageBox::question(centralWidget, tr("Split Item?"),
-                                    tr("Split current element at clicked point X coordinate?"));
+                                    tr("Split current element at %n cut point(s)?", nullptr, points.size()));
     if(ret != QMessageBox::Yes)
         return; //Abort
 
+    //All cuts are applied in one pass, renderer is rebuilt once
     const auto plan = getStationPlan();
     ElementSplitterHelper helper(this, converter->currentWalker.element(), plan->platformPenWidth);
-    if(!helper.splitAt(pos))
+    if(!helper.splitAt(points))
     {
         QMessageBox::warning(centralWidget, tr("No split"),
                              tr("Cannot calculate split point, did you click outside of path bounds?"
@@ -572,6 +856,9 @@ void NodeFinderMgr::triggerElementSplit(const QPointF& pos)
         return;
     }
 
+    //Rebuild renderer in background, edits in quick succession are merged
+    converter->scheduleSVGRendererReload();
+
     //Current element might be removed so reset walker
     clearCurrentItem();
 }
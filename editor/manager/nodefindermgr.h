@@ -7,8 +7,10 @@
 
 #include <QPointF>
 #include <QRectF>
+#include <QStringList>
 
 #include "utils/nodefindereditingmodes.h"
+#include "nodefinderrepaintscheduler.h"
 
 namespace ssplib {
 struct ItemBase;
@@ -19,12 +21,18 @@ class EditingInfo;
 class QIODevice;
 class QWidget;
 class NodeFinderSVGConverter;
+class NodeFinderUndoJournal;
+class NodeFinderDocumentLoader;
+class NodeFinderSelectionPreview;
+class NodeFinderSuggestionEngine;
+struct NodeFinderSuggestion;
 
 class NodeFinderMgr : public QObject
 {
     Q_OBJECT
 public:
     explicit NodeFinderMgr(QObject *parent = nullptr);
+    ~NodeFinderMgr();
 
     //Editing mode
     EditingModes mode() const;
@@ -40,7 +48,11 @@ public:
     int getTrackPenWidth() const;
 
     //Loading/Saving
+    //SVG is loaded in background, takes ownership of device
+    //svgLoaded() is emitted when finished
     bool loadSVG(QIODevice *dev);
+    inline bool isLoadingSVG() const { return m_mode == EditingModes::LoadingSVG; }
+    inline NodeFinderDocumentLoader *getDocumentLoader() const { return documentLoader; }
     bool saveSVG(QIODevice *dev);
 
     bool loadXML(QIODevice *dev);
@@ -48,6 +60,8 @@ public:
 
     //For NodeFinderSVGWidget
     inline NodeFinderSVGConverter *getConverter() const { return converter; }
+    inline NodeFinderUndoJournal *getJournal() const { return journal; }
+    inline NodeFinderRepaintScheduler *getRepaintScheduler() const { return repaintScheduler; }
     ssplib::StationPlan *getStationPlan() const;
     ssplib::EditingInfo *getEditingInfo() const;
 
@@ -58,15 +72,36 @@ public:
     inline bool isSelecting() const { return m_isSelecting; }
     inline QRectF getSelectionRect() const { return QRectF(selectionStart, selectionEnd).normalized(); }
 
+    //Elements captured by current rubber band, active only while dragging
+    inline const NodeFinderSelectionPreview *getSelectionPreview() const { return selectionPreview; }
+
     void startElementSplitProcess();
-    void triggerElementSplit(const QPointF &pos);
+
+    //Cut points placed on current element, applied together
+    inline const QList<QPointF>& getSplitPoints() const { return m_splitPoints; }
+    void addSplitPoint(const QPointF& pos);
+    void triggerElementSplit(const QList<QPointF> &points);
+
+    //Tag suggestions, shown when not editing
+    const QList<NodeFinderSuggestion>& getSuggestions() const;
+    inline int currentSuggestion() const { return m_curSuggestion; }
+    inline bool suggestionsActive() const { return m_suggestionsActive; }
 
 signals:
+    //Emitted once per event loop iteration, use requestRepaint() to trigger
     void modeChanged();
     void trackPenWidthChanged(int width);
     void repaintSVG();
+    void repaintSelection();
+    void svgLoaded(bool ok, bool cancelled);
+
+    //Rubber band moved, only overlay needs repaint
+    void selectionMoved(const QRectF& oldRect, const QRectF& newRect);
 
 public slots:
+    //Refresh is delayed and coalesced
+    inline void requestRepaint(NodeFinderRepaintScheduler::DirtyFlags flags) { repaintScheduler->markDirty(flags); }
+
     //Track Pen
     void setTrackPenWidth(int value);
 
@@ -81,10 +116,23 @@ public slots:
     void clearCurrentItem();
     void requestEditItem(ssplib::ItemBase *item, EditingModes m);
 
+    void computeSuggestions();
+    void acceptCurrentSuggestion();
+    void rejectCurrentSuggestion();
+    void acceptAllSuggestions();
+    void clearSuggestions();
+
 private:
     void setMode(EditingModes m, EditingSubModes sub = EditingSubModes::NotEditingCurrentItem);
     bool validateCurrentElement();
 
+    void onDocumentLoaded(bool ok, bool cancelled);
+
+    QStringList getSelectableTags() const;
+
+    bool applySuggestion(const NodeFinderSuggestion& s);
+    void refreshSuggestions();
+
 private:
     EditingModes m_mode;
     EditingSubModes m_subMode;
@@ -92,10 +140,19 @@ private:
     QPointer<QWidget> statusWidget;
     QPointer<QWidget> centralWidget;
 
+    NodeFinderRepaintScheduler *repaintScheduler;
     NodeFinderSVGConverter *converter;
+    NodeFinderUndoJournal *journal;
+    NodeFinderDocumentLoader *documentLoader;
+    NodeFinderSuggestionEngine *suggestionEngine;
+    NodeFinderSelectionPreview *selectionPreview;
+    int m_curSuggestion;
+    bool m_suggestionsActive;
+    bool m_applyingSuggestions;
 
     QPointF selectionStart;
     QPointF selectionEnd;
+    QList<QPointF> m_splitPoints;
     bool m_isSelecting;
     bool m_isSinglePoint;
 };
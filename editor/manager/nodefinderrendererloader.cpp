@@ -0,0 +1,142 @@
+#include "nodefinderrendererloader.h"
+
+#include <QSvgRenderer>
+#include <QDomDocument>
+#include <QXmlStreamReader>
+
+#include <QThread>
+
+#include <ssplib/utils/tracing.h>
+
+//Wait for edits to settle before rebuilding
+static constexpr int ReloadDelayMsec = 150;
+
+static bool loadRenderer(QSvgRenderer *svg, const QDomDocument& doc)
+{
+    //Serialize in memory without indentation, renderer does not need it.
+    //Fake IDs are harmless for rendering so they are kept.
+    const QByteArray content = doc.toByteArray(-1);
+
+    QXmlStreamReader xml(content);
+    return svg->load(&xml);
+}
+
+NodeFinderRendererLoader::NodeFinderRendererLoader(QDomDocument *doc, QObject *parent) :
+    QObject(parent),
+    m_doc(doc),
+    m_generation(0),
+    m_dirty(false),
+    m_running(false)
+{
+    m_renderer.reset(new QSvgRenderer);
+
+    //Keep document snapshots ordered, one rebuild at a time
+    m_pool.setMaxThreadCount(1);
+
+    m_debounceTimer.setSingleShot(true);
+    m_debounceTimer.setInterval(ReloadDelayMsec);
+    connect(&m_debounceTimer, &QTimer::timeout, this, &NodeFinderRendererLoader::startReload);
+}
+
+NodeFinderRendererLoader::~NodeFinderRendererLoader()
+{
+    //Worker posts result to this object, wait for it before deleting
+    m_debounceTimer.stop();
+    m_pool.waitForDone();
+}
+
+void NodeFinderRendererLoader::loadNow()
+{
+    m_debounceTimer.stop();
+    m_dirty = false;
+
+    //Discard running rebuild
+    m_generation++;
+
+    QSharedPointer<QSvgRenderer> svg(new QSvgRenderer);
+    loadRenderer(svg.data(), *m_doc);
+    setRenderer(svg);
+}
+
+void NodeFinderRendererLoader::cancelReload()
+{
+    m_debounceTimer.stop();
+    m_dirty = false;
+
+    //Result of running rebuild will be discarded
+    m_generation++;
+}
+
+void NodeFinderRendererLoader::setLoadedRenderer(QSharedPointer<QSvgRenderer> svg)
+{
+    cancelReload();
+    setRenderer(svg);
+}
+
+QSharedPointer<QSvgRenderer> NodeFinderRendererLoader::createRenderer(const QDomDocument &doc)
+{
+    SSPLIB_TRACE_SCOPE_CAT("NodeFinderRendererLoader::createRenderer", "editor");
+
+    QSharedPointer<QSvgRenderer> svg(new QSvgRenderer);
+    if(!loadRenderer(svg.data(), doc))
+        svg.reset();
+    return svg;
+}
+
+void NodeFinderRendererLoader::scheduleReload()
+{
+    m_dirty = true;
+    m_debounceTimer.start();
+}
+
+void NodeFinderRendererLoader::startReload()
+{
+    if(m_running)
+    {
+        //Start again when current rebuild finishes
+        m_dirty = true;
+        return;
+    }
+
+    m_dirty = false;
+    m_running = true;
+
+    const quint64 generation = ++m_generation;
+    QThread *guiThread = thread();
+
+    //Deep copy so editing can go on while worker serializes it
+    const QDomDocument snapshot = m_doc->cloneNode(true).toDocument();
+
+    m_pool.start([this, snapshot, generation, guiThread]()
+    {
+        QSharedPointer<QSvgRenderer> svg = createRenderer(snapshot);
+        if(svg)
+            svg->moveToThread(guiThread);
+
+        QMetaObject::invokeMethod(this, [this, generation, svg]()
+            {
+                onReloadFinished(generation, svg);
+            }, Qt::QueuedConnection);
+    });
+}
+
+void NodeFinderRendererLoader::onReloadFinished(quint64 generation, QSharedPointer<QSvgRenderer> svg)
+{
+    m_running = false;
+
+    //Keep old renderer on errors or if superseded by loadNow()
+    if(svg && generation == m_generation)
+        setRenderer(svg);
+
+    //If timer is active it will start rebuild by itself
+    if(m_dirty && !m_debounceTimer.isActive())
+        startReload();
+}
+
+void NodeFinderRendererLoader::setRenderer(QSharedPointer<QSvgRenderer> svg)
+{
+    //Keep old renderer alive until views switched to new one
+    QSharedPointer<QSvgRenderer> oldRenderer = m_renderer;
+    m_renderer = svg;
+    emit rendererChanged(m_renderer.data());
+}
@@ -0,0 +1,66 @@
+#ifndef NODEFINDERRENDERERLOADER_H
+#define NODEFINDERRENDERERLOADER_H
+
+#include <QObject>
+#include <QSharedPointer>
+#include <QThreadPool>
+#include <QTimer>
+
+class QSvgRenderer;
+class QDomDocument;
+
+//Rebuilds QSvgRenderer from editor document
+//Requests are coalesced and serialization + parsing run in a worker thread
+//on a snapshot of the document. Current renderer is kept until new one is ready.
+class NodeFinderRendererLoader : public QObject
+{
+    Q_OBJECT
+public:
+    explicit NodeFinderRendererLoader(QDomDocument *doc, QObject *parent = nullptr);
+    ~NodeFinderRendererLoader();
+
+    inline QSvgRenderer *renderer() const { return m_renderer.data(); }
+
+    //Load on GUI thread, pending rebuilds are discarded
+    void loadNow();
+
+    //Rebuild after a short delay, successive calls trigger a single rebuild
+    void scheduleReload();
+
+    inline bool isReloadPending() const { return m_dirty || m_running; }
+
+    //Discard pending and running rebuilds, current renderer is kept
+    void cancelReload();
+
+    //Install renderer built elsewhere, pending rebuilds are discarded
+    void setLoadedRenderer(QSharedPointer<QSvgRenderer> svg);
+
+    //Can be called from any thread, returns null on errors
+    //Renderer must be moved to GUI thread before use
+    static QSharedPointer<QSvgRenderer> createRenderer(const QDomDocument& doc);
+
+signals:
+    void rendererChanged(QSvgRenderer *svg);
+
+private slots:
+    void startReload();
+
+private:
+    void onReloadFinished(quint64 generation, QSharedPointer<QSvgRenderer> svg);
+    void setRenderer(QSharedPointer<QSvgRenderer> svg);
+
+private:
+    QDomDocument *m_doc;
+    QSharedPointer<QSvgRenderer> m_renderer;
+
+    QTimer m_debounceTimer;
+    QThreadPool m_pool;
+
+    //Results of outdated requests are discarded
+    quint64 m_generation;
+
+    bool m_dirty;
+    bool m_running;
+};
+
+#endif // NODEFINDERRENDERERLOADER_H
@@ -0,0 +1,60 @@
+#include "nodefinderrepaintscheduler.h"
+
+NodeFinderRepaintScheduler::NodeFinderRepaintScheduler(QObject *parent) :
+    QObject(parent),
+    m_flushQueued(false)
+{
+
+}
+
+void NodeFinderRepaintScheduler::markDirty(DirtyFlags flags)
+{
+    m_stats.requests++;
+    m_pending |= flags;
+
+    if(m_flushQueued || m_pending == NoFlags)
+        return;
+
+    //Run after current action returns to event loop
+    m_flushQueued = true;
+    QMetaObject::invokeMethod(this, &NodeFinderRepaintScheduler::flush, Qt::QueuedConnection);
+}
+
+void NodeFinderRepaintScheduler::flush()
+{
+    m_flushQueued = false;
+
+    //Receivers may request again, they will be flushed next time
+    const DirtyFlags flags = m_pending;
+    m_pending = NoFlags;
+
+    if(flags == NoFlags)
+        return;
+
+    m_stats.flushes++;
+
+    //Models first so views repaint with updated data
+    if(flags.testFlag(Models))
+    {
+        m_stats.modelRefreshes++;
+        emit modelsRefreshRequested();
+    }
+
+    if(flags.testFlag(Mode))
+    {
+        m_stats.modeUpdates++;
+        emit modeRefreshRequested();
+    }
+
+    if(flags & (Overlay | Background))
+    {
+        //Content repaint includes selection
+        m_stats.contentRepaints++;
+        emit contentRepaintRequested();
+    }
+    else if(flags.testFlag(Selection))
+    {
+        m_stats.selectionRepaints++;
+        emit selectionRepaintRequested();
+    }
+}
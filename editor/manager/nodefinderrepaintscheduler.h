@@ -0,0 +1,63 @@
+#ifndef NODEFINDERREPAINTSCHEDULER_H
+#define NODEFINDERREPAINTSCHEDULER_H
+
+#include <QObject>
+
+//Collects what must be refreshed during a user action and refreshes it once
+//Flags are flushed on next event loop iteration, so an action emitting
+//many requests causes a single repaint, model refresh and mode update.
+class NodeFinderRepaintScheduler : public QObject
+{
+    Q_OBJECT
+public:
+    enum DirtyFlag
+    {
+        NoFlags = 0,
+        Overlay = 1 << 0, //Current item, cut points, suggestions
+        Selection = 1 << 1, //Rubber band
+        Background = 1 << 2, //SVG image and station plan items
+        Models = 1 << 3, //Model data depending on other models
+        Mode = 1 << 4 //Editing mode and status
+    };
+    Q_DECLARE_FLAGS(DirtyFlags, DirtyFlag)
+
+    //For verifying how many refreshes an action causes
+    struct Stats
+    {
+        int requests = 0;
+        int flushes = 0;
+        int contentRepaints = 0; //Overlay or background
+        int selectionRepaints = 0; //Only selection changed
+        int modelRefreshes = 0;
+        int modeUpdates = 0;
+    };
+
+    explicit NodeFinderRepaintScheduler(QObject *parent = nullptr);
+
+    void markDirty(DirtyFlags flags);
+
+    inline DirtyFlags pendingFlags() const { return m_pending; }
+
+    inline const Stats& stats() const { return m_stats; }
+    inline void resetStats() { m_stats = Stats(); }
+
+public slots:
+    //Refresh pending flags now, called automatically
+    void flush();
+
+signals:
+    void contentRepaintRequested();
+    void selectionRepaintRequested();
+    void modelsRefreshRequested();
+    void modeRefreshRequested();
+
+private:
+    DirtyFlags m_pending;
+    bool m_flushQueued;
+
+    Stats m_stats;
+};
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(NodeFinderRepaintScheduler::DirtyFlags)
+
+#endif // NODEFINDERREPAINTSCHEDULER_H
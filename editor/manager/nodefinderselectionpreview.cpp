@@ -0,0 +1,104 @@
+#include "nodefinderselectionpreview.h"
+
+#include "nodefindersvgconverter.h"
+
+NodeFinderSelectionPreview::NodeFinderSelectionPreview(NodeFinderSVGConverter *conv) :
+    m_conv(conv),
+    m_active(false)
+{
+
+}
+
+void NodeFinderSelectionPreview::start(const QStringList &tags, const QPointF &origin)
+{
+    m_tagIds = m_conv->elementRegistry.tagIdsFor(tags);
+    m_origin = origin;
+    m_rect = QRectF();
+    m_captured.clear();
+    m_active = true;
+}
+
+void NodeFinderSelectionPreview::update(const QRectF &rect)
+{
+    if(!m_active || rect == m_rect)
+        return;
+
+    //New elements must reach outside previous rectangle
+    const QList<QRectF> addedAreas = rectDifference(rect, m_rect);
+    m_rect = rect;
+
+    //Drop elements not contained anymore
+    for(auto it = m_captured.begin(); it != m_captured.end();)
+    {
+        if(isContained(it.value().bounds))
+            ++it;
+        else
+            it = m_captured.erase(it);
+    }
+
+    for(const QRectF& area : addedAreas)
+    {
+        const QList<NodeFinderSpatialIndex::Entry> entries = m_conv->spatialIndex.query(area, m_tagIds, m_origin);
+        for(const NodeFinderSpatialIndex::Entry& entry : entries)
+        {
+            const qint64 key = (qint64(entry.tagId) << 32) | quint32(entry.elemIdx);
+            if(m_captured.contains(key))
+                continue;
+
+            const QDomElement e = m_conv->elementRegistry.classAt(entry.tagId).elementAt(entry.elemIdx);
+
+            ssplib::ElementPath elemPath;
+            Captured item;
+            if(e.isNull() || !m_conv->getElementPath(e, elemPath, &item.bounds) || !isContained(item.bounds))
+                continue;
+
+            item.path = elemPath.path;
+            m_captured.insert(key, item);
+        }
+    }
+}
+
+void NodeFinderSelectionPreview::clear()
+{
+    m_tagIds.clear();
+    m_rect = QRectF();
+    m_captured.clear();
+    m_captured.squeeze();
+    m_active = false;
+}
+
+QList<QRectF> NodeFinderSelectionPreview::rectDifference(const QRectF &a, const QRectF &b)
+{
+    if(!a.intersects(b))
+        return {a};
+
+    QList<QRectF> result;
+
+    //Full width bands above and below b
+    if(b.top() > a.top())
+        result.append(QRectF(a.left(), a.top(), a.width(), b.top() - a.top()));
+    if(b.bottom() < a.bottom())
+        result.append(QRectF(a.left(), b.bottom(), a.width(), a.bottom() - b.bottom()));
+
+    //Sides of b in remaining band
+    const qreal top = qMax(a.top(), b.top());
+    const qreal bottom = qMin(a.bottom(), b.bottom());
+    if(b.left() > a.left())
+        result.append(QRectF(a.left(), top, b.left() - a.left(), bottom - top));
+    if(b.right() < a.right())
+        result.append(QRectF(b.right(), top, a.right() - b.right(), bottom - top));
+
+    return result;
+}
+
+bool NodeFinderSelectionPreview::isContained(const QRectF &bounds) const
+{
+    //Same check of NodeFinderMgr::validateCurrentElement()
+    //Null rect breaks QRectF::contains() which returns always false
+    QRectF r = bounds;
+    if(r.width() == 0)
+        r.setWidth(1);
+    if(r.height() == 0)
+        r.setHeight(1);
+    return m_rect.contains(r);
+}
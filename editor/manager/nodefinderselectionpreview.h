@@ -0,0 +1,55 @@
+#ifndef NODEFINDERSELECTIONPREVIEW_H
+#define NODEFINDERSELECTIONPREVIEW_H
+
+#include <QHash>
+#include <QList>
+#include <QStringList>
+#include <QRectF>
+#include <QPainterPath>
+
+class NodeFinderSVGConverter;
+
+//Elements which a rubber band selection would capture, updated while dragging
+//Captured elements are checked against the new rectangle and the spatial index
+//is queried only on the area not covered by the previous rectangle,
+//so cost depends on the change in rectangle, not on its size.
+class NodeFinderSelectionPreview
+{
+public:
+    struct Captured
+    {
+        QPainterPath path;
+        QRectF bounds;
+    };
+
+    explicit NodeFinderSelectionPreview(NodeFinderSVGConverter *conv);
+
+    void start(const QStringList& tags, const QPointF& origin);
+    void update(const QRectF& rect);
+    void clear();
+
+    inline bool isActive() const { return m_active; }
+    inline int count() const { return m_captured.size(); }
+    inline QRectF rect() const { return m_rect; }
+    inline const QHash<qint64, Captured>& captured() const { return m_captured; }
+
+    //Parts of a not covered by b
+    static QList<QRectF> rectDifference(const QRectF& a, const QRectF& b);
+
+private:
+    bool isContained(const QRectF& bounds) const;
+
+private:
+    NodeFinderSVGConverter *m_conv;
+
+    QList<int> m_tagIds;
+    QPointF m_origin;
+    QRectF m_rect;
+
+    //Keyed by tag id and element index
+    QHash<qint64, Captured> m_captured;
+
+    bool m_active;
+};
+
+#endif // NODEFINDERSELECTIONPREVIEW_H
@@ -0,0 +1,212 @@
+#include "nodefinderspatialindex.h"
+
+#include <QtMath>
+
+#include <algorithm>
+
+static constexpr int NodeCapacity = 16;
+
+//Rebuild tree when this many entries are updated
+static constexpr int MinExtraBeforeRebuild = 64;
+
+//Reorder items so consecutive chunks of NodeCapacity are spatially close
+template <typename T>
+static void sortTileRecursive(QList<T>& items)
+{
+    const int n = items.size();
+    const int leafCount = (n + NodeCapacity - 1) / NodeCapacity;
+    const int sliceCount = qCeil(qSqrt(leafCount));
+    const int sliceSize = sliceCount * NodeCapacity;
+
+    std::sort(items.begin(), items.end(), [](const T& a, const T& b)
+              {
+                  return a.bounds.center().x() < b.bounds.center().x();
+              });
+
+    for(int i = 0; i < n; i += sliceSize)
+    {
+        std::sort(items.begin() + i, items.begin() + qMin(i + sliceSize, n), [](const T& a, const T& b)
+                  {
+                      return a.bounds.center().y() < b.bounds.center().y();
+                  });
+    }
+}
+
+static double distanceToRect(const QRectF& r, const QPointF& p)
+{
+    const double dx = qMax(qMax(r.left() - p.x(), 0.0), p.x() - r.right());
+    const double dy = qMax(qMax(r.top() - p.y(), 0.0), p.y() - r.bottom());
+    return qSqrt(dx * dx + dy * dy);
+}
+
+NodeFinderSpatialIndex::NodeFinderSpatialIndex() :
+    m_root(-1),
+    m_built(false)
+{
+
+}
+
+void NodeFinderSpatialIndex::clear()
+{
+    m_entries.clear();
+    m_nodes.clear();
+    m_root = -1;
+    m_extra.clear();
+    m_extraIndex.clear();
+    m_built = false;
+}
+
+void NodeFinderSpatialIndex::build(const QList<Entry> &entries)
+{
+    clear();
+
+    m_entries = entries;
+    sortTileRecursive(m_entries);
+
+    //Create leaves
+    QList<Node> level;
+    level.reserve(m_entries.size() / NodeCapacity + 1);
+    for(int i = 0; i < m_entries.size(); i += NodeCapacity)
+    {
+        Node leaf;
+        leaf.first = i;
+        leaf.count = qMin(NodeCapacity, int(m_entries.size()) - i);
+        leaf.isLeaf = true;
+        leaf.bounds = m_entries.at(i).bounds;
+        for(int j = 1; j < leaf.count; j++)
+            leaf.bounds |= m_entries.at(i + j).bounds;
+        level.append(leaf);
+    }
+
+    //Pack each level into parents until a single root is left
+    while(level.size() > 1)
+    {
+        sortTileRecursive(level);
+
+        const int base = m_nodes.size();
+        m_nodes.append(level);
+
+        QList<Node> parents;
+        parents.reserve(level.size() / NodeCapacity + 1);
+        for(int i = 0; i < level.size(); i += NodeCapacity)
+        {
+            Node parent;
+            parent.first = base + i;
+            parent.count = qMin(NodeCapacity, int(level.size()) - i);
+            parent.isLeaf = false;
+            parent.bounds = level.at(i).bounds;
+            for(int j = 1; j < parent.count; j++)
+                parent.bounds |= level.at(i + j).bounds;
+            parents.append(parent);
+        }
+
+        level = parents;
+    }
+
+    if(!level.isEmpty())
+    {
+        m_root = m_nodes.size();
+        m_nodes.append(level.first());
+    }
+
+    m_built = true;
+}
+
+void NodeFinderSpatialIndex::update(const Entry &entry)
+{
+    const qint64 key = entryKey(entry.tagId, entry.elemIdx);
+    auto it = m_extraIndex.constFind(key);
+    if(it != m_extraIndex.constEnd())
+    {
+        m_extra[it.value()] = entry;
+        return;
+    }
+
+    m_extraIndex.insert(key, m_extra.size());
+    m_extra.append(entry);
+
+    if(m_extra.size() > qMax(MinExtraBeforeRebuild, int(m_entries.size()) / 4))
+        rebuild();
+}
+
+QList<NodeFinderSpatialIndex::Entry> NodeFinderSpatialIndex::query(const QRectF &area, const QList<int> &tagIds,
+                                                                   const QPointF &refPoint)
+{
+    QList<Entry> result;
+
+    //Null rect never intersects, use single point rect
+    QRectF queryRect = area.normalized();
+    if(queryRect.width() == 0)
+        queryRect.setWidth(1e-6);
+    if(queryRect.height() == 0)
+        queryRect.setHeight(1e-6);
+
+    auto accept = [&tagIds, &queryRect](const Entry& e)
+    {
+        return tagIds.contains(e.tagId) && e.bounds.intersects(queryRect);
+    };
+
+    if(m_root >= 0)
+    {
+        QList<int> stack;
+        stack.append(m_root);
+        while(!stack.isEmpty())
+        {
+            const Node& node = m_nodes.at(stack.takeLast());
+            if(!node.bounds.intersects(queryRect))
+                continue;
+
+            if(!node.isLeaf)
+            {
+                for(int i = 0; i < node.count; i++)
+                    stack.append(node.first + i);
+                continue;
+            }
+
+            for(int i = 0; i < node.count; i++)
+            {
+                const Entry& e = m_entries.at(node.first + i);
+                if(!accept(e))
+                    continue;
+
+                if(m_extraIndex.contains(entryKey(e.tagId, e.elemIdx)))
+                    continue; //Outdated, updated entry is in extra list
+
+                result.append(e);
+            }
+        }
+    }
+
+    for(const Entry& e : std::as_const(m_extra))
+    {
+        if(accept(e))
+            result.append(e);
+    }
+
+    std::sort(result.begin(), result.end(), [&refPoint](const Entry& a, const Entry& b)
+              {
+                  const double distA = distanceToRect(a.bounds, refPoint);
+                  const double distB = distanceToRect(b.bounds, refPoint);
+                  if(distA != distB)
+                      return distA < distB;
+
+                  return a.bounds.width() * a.bounds.height() < b.bounds.width() * b.bounds.height();
+              });
+
+    return result;
+}
+
+void NodeFinderSpatialIndex::rebuild()
+{
+    QList<Entry> entries;
+    entries.reserve(m_entries.size() + m_extra.size());
+
+    for(const Entry& e : std::as_const(m_entries))
+    {
+        if(!m_extraIndex.contains(entryKey(e.tagId, e.elemIdx)))
+            entries.append(e);
+    }
+    entries.append(m_extra);
+
+    build(entries);
+}
@@ -0,0 +1,63 @@
+#ifndef NODEFINDERSPATIALINDEX_H
+#define NODEFINDERSPATIALINDEX_H
+
+#include <QRectF>
+#include <QList>
+#include <QHash>
+
+//Static R-tree of selectable element bounds, bulk loaded with Sort-Tile-Recursive
+//Elements changed after build are kept in a small linear list
+//until it grows enough to rebuild the tree.
+class NodeFinderSpatialIndex
+{
+public:
+    struct Entry
+    {
+        QRectF bounds; //Element bounds grown by stroke width
+        int tagId = -1;
+        int elemIdx = -1;
+    };
+
+    NodeFinderSpatialIndex();
+
+    void clear();
+
+    void build(const QList<Entry>& entries);
+    inline bool isBuilt() const { return m_built; }
+
+    //Add or replace element bounds
+    void update(const Entry& entry);
+
+    //Elements of given tags whose bounds intersect area
+    //Ordered by distance from refPoint, smaller elements first on ties
+    QList<Entry> query(const QRectF& area, const QList<int>& tagIds, const QPointF& refPoint);
+
+private:
+    struct Node
+    {
+        QRectF bounds;
+        int first = 0; //First child node or first entry for leaves
+        int count = 0;
+        bool isLeaf = true;
+    };
+
+    static inline qint64 entryKey(int tagId, int elemIdx)
+    {
+        return (qint64(tagId) << 32) | quint32(elemIdx);
+    }
+
+    void rebuild();
+
+private:
+    QList<Entry> m_entries;
+    QList<Node> m_nodes;
+    int m_root;
+
+    //Entries updated after build, they override tree entries with same key
+    QList<Entry> m_extra;
+    QHash<qint64, int> m_extraIndex;
+
+    bool m_built;
+};
+
+#endif // NODEFINDERSPATIALINDEX_H
@@ -0,0 +1,405 @@
+#include "nodefindersuggestionengine.h"
+
+#include "nodefindersvgconverter.h"
+
+#include "model/iobjectmodel.h"
+
+#include <ssplib/stationplan.h>
+#include <ssplib/utils/svg_constants.h>
+
+#include <QPainterPathStroker>
+#include <QLineF>
+
+#include <algorithm>
+#include <cmath>
+
+//Maximum angle in degrees between a track and its extension
+static constexpr qreal MaxExtensionAngle = 10;
+
+static bool isParallel(const QLineF& a, const QLineF& b)
+{
+    if(a.isNull() || b.isNull())
+        return false;
+
+    qreal angle = std::fmod(a.angleTo(b), 180.0);
+    return angle < MaxExtensionAngle || angle > 180.0 - MaxExtensionAngle;
+}
+
+QString NodeFinderSuggestion::key() const
+{
+    QStringList ids;
+    ids.reserve(elements.size());
+    for(const ssplib::ElementPath& p : elements)
+        ids.append(p.elem.attribute(ssplib::svg_attr::ID));
+    ids.sort();
+
+    QString str;
+    if(type == Type::TrackPos)
+    {
+        str = QString("P%1:").arg(trackPos);
+    }
+    else
+    {
+        str = QString("C%1/%2/%3/%4:")
+                  .arg(connInfo.stationTrackPos)
+                  .arg(int(connInfo.trackSide))
+                  .arg(connInfo.gateLetter)
+                  .arg(connInfo.gateTrackPos);
+    }
+
+    return str + ids.join(QLatin1Char(','));
+}
+
+NodeFinderSuggestionEngine::NodeFinderSuggestionEngine(NodeFinderSVGConverter *conv) :
+    m_conv(conv)
+{
+
+}
+
+void NodeFinderSuggestionEngine::compute(const ssplib::StationPlan *plan, qreal tolerance)
+{
+    m_suggestions.clear();
+
+    collectUntaggedElements(plan);
+
+    //Build graph of station tracks and untagged elements
+    m_topology.reset(tolerance);
+
+    for(int i = 0; i < plan->platforms.size(); i++)
+    {
+        const ssplib::TrackItem& item = plan->platforms.at(i);
+        for(int elemIdx = 0; elemIdx < item.elements.size(); elemIdx++)
+            m_topology.addSegments({ssplib::StationTopology::ItemType::Platform, i}, elemIdx, item.elements.at(elemIdx).path);
+    }
+
+    for(int i = 0; i < m_elements.size(); i++)
+        m_topology.addSegments({ssplib::StationTopology::ItemType::Element, i}, i, m_elements.at(i).path);
+
+    for(int i = 0; i < plan->labels.size(); i++)
+    {
+        QRectF bounds;
+        for(const ssplib::ElementPath& p : plan->labels.at(i).elements)
+            bounds = bounds.united(p.path.boundingRect());
+
+        if(!bounds.isNull())
+            m_topology.attachLabel(i, bounds);
+    }
+
+    suggestTrackExtensions(plan);
+    suggestConnections(plan);
+
+    //Free graph, suggestions keep their elements
+    m_topology.clear();
+    m_elements.clear();
+    m_isExtension.clear();
+}
+
+int NodeFinderSuggestionEngine::suggestionAt(const QPointF &pos, qreal tolerance) const
+{
+    QPainterPathStroker stroker;
+    stroker.setWidth(tolerance * 2);
+
+    for(int i = 0; i < m_suggestions.size(); i++)
+    {
+        const NodeFinderSuggestion& s = m_suggestions.at(i);
+        if(!s.bounds.adjusted(-tolerance, -tolerance, tolerance, tolerance).contains(pos))
+            continue;
+
+        for(const ssplib::ElementPath& p : s.elements)
+        {
+            if(stroker.createStroke(p.path).contains(pos))
+                return i;
+        }
+    }
+
+    return -1;
+}
+
+void NodeFinderSuggestionEngine::reject(int idx)
+{
+    if(idx < 0 || idx >= m_suggestions.size())
+        return;
+
+    m_rejected.insert(m_suggestions.at(idx).key());
+    m_suggestions.removeAt(idx);
+}
+
+void NodeFinderSuggestionEngine::clearRejected()
+{
+    m_rejected.clear();
+}
+
+void NodeFinderSuggestionEngine::clear()
+{
+    m_suggestions.clear();
+    m_rejected.clear();
+}
+
+void NodeFinderSuggestionEngine::collectUntaggedElements(const ssplib::StationPlan *plan)
+{
+    m_elements.clear();
+
+    QSet<QString> taggedIds;
+    auto addTaggedIds = [&taggedIds](const ssplib::ItemBase& item)
+    {
+        for(const ssplib::ElementPath& p : item.elements)
+            taggedIds.insert(p.elem.attribute(ssplib::svg_attr::ID));
+    };
+
+    for(const ssplib::LabelItem& item : plan->labels)
+        addTaggedIds(item);
+    for(const ssplib::TrackItem& item : plan->platforms)
+        addTaggedIds(item);
+    for(const ssplib::TrackConnectionItem& item : plan->trackConnections)
+        addTaggedIds(item);
+
+    const QStringList tags{ssplib::svg_tags::PathTag, ssplib::svg_tags::LineTag, ssplib::svg_tags::PolylineTag};
+    for(const QString& tag : tags)
+    {
+        const NodeFinderElementClass *c = m_conv->elementRegistry.classForTag(tag);
+        if(!c)
+            continue;
+
+        for(int i = 0; i < c->count(); i++)
+        {
+            const QDomElement e = c->elementAt(i);
+            if(e.isNull() || taggedIds.contains(e.attribute(ssplib::svg_attr::ID)))
+                continue;
+
+            ssplib::ElementPath p;
+            if(m_conv->getElementPath(e, p))
+                m_elements.append(p);
+        }
+    }
+
+    m_isExtension.fill(false, m_elements.size());
+}
+
+void NodeFinderSuggestionEngine::suggestTrackExtensions(const ssplib::StationPlan *plan)
+{
+    const QList<ssplib::StationTopology::Segment>& segments = m_topology.segments();
+    const QList<ssplib::StationTopology::Junction>& junctions = m_topology.junctions();
+
+    auto segmentLine = [&](const ssplib::StationTopology::Segment& seg)
+    {
+        return QLineF(junctions.at(seg.junctions[0]).pos, junctions.at(seg.junctions[1]).pos);
+    };
+
+    for(int k = 0; k < m_elements.size(); k++)
+    {
+        int platformIdx = -1;
+
+        const QList<int> elemSegments = m_topology.segmentsOfItem({ssplib::StationTopology::ItemType::Element, k});
+        for(int segIdx : elemSegments)
+        {
+            const ssplib::StationTopology::Segment& seg = segments.at(segIdx);
+            const QLineF line = segmentLine(seg);
+
+            for(int j : seg.junctions)
+            {
+                for(int otherIdx : junctions.at(j).segments)
+                {
+                    const ssplib::StationTopology::Segment& other = segments.at(otherIdx);
+                    if(other.item.type == ssplib::StationTopology::ItemType::Platform && isParallel(line, segmentLine(other)))
+                    {
+                        platformIdx = other.item.itemIdx;
+                        break;
+                    }
+                }
+                if(platformIdx >= 0)
+                    break;
+            }
+            if(platformIdx >= 0)
+                break;
+        }
+
+        if(platformIdx < 0)
+            continue;
+
+        const ssplib::TrackItem& track = plan->platforms.at(platformIdx);
+
+        NodeFinderSuggestion s;
+        s.type = NodeFinderSuggestion::Type::TrackPos;
+        s.elements.append(m_elements.at(k));
+        s.trackPos = track.trackPos;
+        s.description = track.trackName.isEmpty() ? QString("#%1").arg(track.trackPos) : track.trackName;
+
+        if(m_rejected.contains(s.key()))
+            continue; //Can be used by connections
+
+        //Extensions are not used for connections
+        m_isExtension[k] = true;
+        addSuggestion(s);
+    }
+}
+
+void NodeFinderSuggestionEngine::suggestConnections(const ssplib::StationPlan *plan)
+{
+    typedef ssplib::StationTopology::ItemType ItemType;
+
+    const QList<ssplib::StationTopology::Segment>& segments = m_topology.segments();
+    const QList<ssplib::StationTopology::Junction>& junctions = m_topology.junctions();
+
+    //Station track touching each junction
+    QList<int> platformAt(junctions.size(), -1);
+    for(int j = 0; j < junctions.size(); j++)
+    {
+        for(int segIdx : junctions.at(j).segments)
+        {
+            if(segments.at(segIdx).item.type == ItemType::Platform)
+            {
+                platformAt[j] = segments.at(segIdx).item.itemIdx;
+                break;
+            }
+        }
+    }
+
+    QList<QRectF> platformBounds;
+    platformBounds.reserve(plan->platforms.size());
+    for(const ssplib::TrackItem& track : plan->platforms)
+    {
+        QRectF bounds;
+        for(const ssplib::ElementPath& p : track.elements)
+            bounds = bounds.united(p.path.boundingRect());
+        platformBounds.append(bounds);
+    }
+
+    //Connections which already have elements are not proposed
+    QSet<quint64> assignedConnections;
+    for(const ssplib::TrackConnectionItem& item : plan->trackConnections)
+    {
+        if(!item.elements.isEmpty())
+            assignedConnections.insert(item.info.namesKey());
+    }
+
+    auto isFreeSegment = [&](int segIdx)
+    {
+        const ssplib::StationTopology::Segment& seg = segments.at(segIdx);
+        return seg.item.type == ItemType::Element && !m_isExtension.at(seg.item.itemIdx);
+    };
+
+    //Breadth first search state, reused with stamps
+    QList<int> visitStamp(junctions.size(), 0);
+    QList<int> prevSegment(junctions.size(), -1);
+    QList<int> queue;
+    int stamp = 0;
+
+    for(int labelIdx = 0; labelIdx < plan->labels.size(); labelIdx++)
+    {
+        const ssplib::LabelItem& gate = plan->labels.at(labelIdx);
+        if(gate.gateLetter.isNull())
+            continue;
+
+        //Gate tracks start from junctions near label
+        QList<int> starts;
+        for(int j : m_topology.junctionsOfItem({ItemType::Label, labelIdx}))
+        {
+            if(platformAt.at(j) >= 0)
+                continue;
+
+            const QList<int>& segs = junctions.at(j).segments;
+            if(std::any_of(segs.cbegin(), segs.cend(), isFreeSegment))
+                starts.append(j);
+        }
+
+        std::sort(starts.begin(), starts.end(), [&junctions](int a, int b) -> bool
+                  {
+                      const QPointF& pa = junctions.at(a).pos;
+                      const QPointF& pb = junctions.at(b).pos;
+                      if(pa.y() == pb.y())
+                          return pa.x() < pb.x();
+                      return pa.y() < pb.y();
+                  });
+
+        for(int gateTrackPos = 0; gateTrackPos < starts.size(); gateTrackPos++)
+        {
+            const int start = starts.at(gateTrackPos);
+
+            stamp++;
+            visitStamp[start] = stamp;
+            prevSegment[start] = -1;
+            queue.clear();
+            queue.append(start);
+
+            QList<int> reached;
+
+            for(int head = 0; head < queue.size(); head++)
+            {
+                const int j = queue.at(head);
+                for(int segIdx : junctions.at(j).segments)
+                {
+                    if(!isFreeSegment(segIdx))
+                        continue;
+
+                    const ssplib::StationTopology::Segment& seg = segments.at(segIdx);
+                    const int other = seg.junctions[0] == j ? seg.junctions[1] : seg.junctions[0];
+                    if(visitStamp.at(other) == stamp)
+                        continue;
+
+                    visitStamp[other] = stamp;
+                    prevSegment[other] = segIdx;
+
+                    if(platformAt.at(other) >= 0)
+                    {
+                        //Connection ends on station track
+                        reached.append(other);
+                        continue;
+                    }
+
+                    if(!junctions.at(other).labels.isEmpty())
+                        continue; //Do not go through gates
+
+                    queue.append(other);
+                }
+            }
+
+            for(int end : std::as_const(reached))
+            {
+                const int platformIdx = platformAt.at(end);
+                const ssplib::TrackItem& track = plan->platforms.at(platformIdx);
+
+                NodeFinderSuggestion s;
+                s.type = NodeFinderSuggestion::Type::TrackConnection;
+                s.connInfo.stationTrackPos = track.trackPos;
+                s.connInfo.gateLetter = gate.gateLetter;
+                s.connInfo.gateTrackPos = gateTrackPos;
+                s.connInfo.trackSide = junctions.at(end).pos.x() < platformBounds.at(platformIdx).center().x()
+                                           ? ssplib::Side::West : ssplib::Side::East;
+
+                if(assignedConnections.contains(s.connInfo.namesKey()))
+                    continue;
+
+                //Walk back to gate
+                QSet<int> used;
+                for(int j = end; prevSegment.at(j) >= 0;)
+                {
+                    const ssplib::StationTopology::Segment& seg = segments.at(prevSegment.at(j));
+                    if(!used.contains(seg.item.itemIdx))
+                    {
+                        used.insert(seg.item.itemIdx);
+                        s.elements.prepend(m_elements.at(seg.item.itemIdx));
+                    }
+                    j = seg.junctions[0] == j ? seg.junctions[1] : seg.junctions[0];
+                }
+
+                s.description = QString("%1%2 - %3 %4")
+                                    .arg(gate.gateLetter)
+                                    .arg(gateTrackPos)
+                                    .arg(track.trackName.isEmpty() ? QString("#%1").arg(track.trackPos) : track.trackName,
+                                         IObjectModel::getTrackSideName(s.connInfo.trackSide));
+                addSuggestion(s);
+            }
+        }
+    }
+}
+
+void NodeFinderSuggestionEngine::addSuggestion(NodeFinderSuggestion &s)
+{
+    if(m_rejected.contains(s.key()))
+        return;
+
+    for(const ssplib::ElementPath& p : std::as_const(s.elements))
+        s.bounds = s.bounds.united(p.path.boundingRect());
+
+    m_suggestions.append(s);
+}
@@ -0,0 +1,83 @@
+#ifndef NODEFINDERSUGGESTIONENGINE_H
+#define NODEFINDERSUGGESTIONENGINE_H
+
+#include <QList>
+#include <QSet>
+
+#include <ssplib/itemtypes.h>
+#include <ssplib/stationtopology.h>
+
+namespace ssplib {
+class StationPlan;
+} // namespace ssplib
+
+class NodeFinderSVGConverter;
+
+//Proposed assignment of untagged elements to a station track or track connection
+struct NodeFinderSuggestion
+{
+    enum class Type
+    {
+        TrackPos = 0,
+        TrackConnection
+    };
+
+    Type type = Type::TrackPos;
+    QList<ssplib::ElementPath> elements;
+
+    int trackPos = 0; //For TrackPos
+    ssplib::TrackConnectionInfo connInfo; //For TrackConnection
+
+    QRectF bounds;
+    QString description;
+
+    //Identifies suggestion across runs, used to remember rejections
+    QString key() const;
+};
+
+//Proposes tags for untagged path, line and polyline elements
+//End points of untagged and station track elements are snapped in a
+//StationTopology graph, then:
+//- Elements touching a station track end and parallel to it extend that track
+//- Elements reachable from a gate label without crossing other tracks or
+//  gates form a connection from gate track to the station track side reached.
+//Gate track positions are numbered by start point, top to bottom.
+//Whole drawing is processed in one pass so it can be re-run after each change.
+class NodeFinderSuggestionEngine
+{
+public:
+    explicit NodeFinderSuggestionEngine(NodeFinderSVGConverter *conv);
+
+    void compute(const ssplib::StationPlan *plan, qreal tolerance);
+
+    inline const QList<NodeFinderSuggestion>& suggestions() const { return m_suggestions; }
+
+    //Returns -1 if no suggestion is near pos
+    int suggestionAt(const QPointF& pos, qreal tolerance) const;
+
+    //Rejected suggestions are not proposed again until clearRejected()
+    void reject(int idx);
+    void clearRejected();
+
+    void clear();
+
+private:
+    void collectUntaggedElements(const ssplib::StationPlan *plan);
+    void suggestTrackExtensions(const ssplib::StationPlan *plan);
+    void suggestConnections(const ssplib::StationPlan *plan);
+
+    void addSuggestion(NodeFinderSuggestion &s);
+
+private:
+    NodeFinderSVGConverter *m_conv;
+
+    QList<NodeFinderSuggestion> m_suggestions;
+    QSet<QString> m_rejected;
+
+    //Current run
+    ssplib::StationTopology m_topology;
+    QList<ssplib::ElementPath> m_elements;
+    QList<bool> m_isExtension;
+};
+
+#endif // NODEFINDERSUGGESTIONENGINE_H
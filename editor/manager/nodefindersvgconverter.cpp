@@ -1,6 +1,8 @@
 #include "nodefindersvgconverter.h"
 
 #include "nodefindermgr.h"
+#include "nodefinderrendererloader.h"
+#include "nodefindersvgwriter.h"
 
 #include "model/nodefinderlabelmodel.h"
 #include "model/nodefinderstationtracksmodel.h"
@@ -11,13 +13,13 @@
 
 #include <ssplib/utils/svg_path_utils.h>
 #include <ssplib/utils/svg_constants.h>
+#include <ssplib/utils/tracing.h>
 
 #include <ssplib/parsing/domparser.h>
 #include <ssplib/parsing/stationinfoparser.h>
 
 #include <QSvgRenderer>
-
-#include <QTemporaryFile>
+#include <QMultiHash>
 
 #include <QDebug>
 
@@ -34,28 +36,33 @@ NodeFinderSVGConverter::NodeFinderSVGConverter(NodeFinderMgr *parent) :
     registerClass(ssplib::svg_tags::LineTag);
     registerClass(ssplib::svg_tags::PolylineTag);
 
-    mSvg = new QSvgRenderer(this);
+    rendererLoader = new NodeFinderRendererLoader(&mDoc, this);
 
     labelsModel = new NodeFinderLabelModel(&m_plan, &m_xmlPlan, nodeMgr, this);
     tracksModel = new NodeFinderStationTracksModel(&m_plan, &m_xmlPlan, nodeMgr, this);
     turnoutModel = new NodeFinderTurnoutModel(&m_plan, &m_xmlPlan, nodeMgr, this);
 
     //Connect models to keep views updated
-    connect(labelsModel, &NodeFinderLabelModel::labelsChanged, turnoutModel, &NodeFinderTurnoutModel::refreshData);
-    connect(tracksModel, &NodeFinderStationTracksModel::tracksChanged, turnoutModel, &NodeFinderTurnoutModel::refreshData);
+    //Refresh once even if many items changed in one action
+    NodeFinderRepaintScheduler *scheduler = nodeMgr->getRepaintScheduler();
+    auto requestModelsRefresh = [scheduler]() { scheduler->markDirty(NodeFinderRepaintScheduler::Models); };
+    connect(labelsModel, &NodeFinderLabelModel::labelsChanged, scheduler, requestModelsRefresh);
+    connect(tracksModel, &NodeFinderStationTracksModel::tracksChanged, scheduler, requestModelsRefresh);
+    connect(scheduler, &NodeFinderRepaintScheduler::modelsRefreshRequested, turnoutModel, &NodeFinderTurnoutModel::refreshData);
 
     m_info.setCallback([this](QDomElement &e) { storeElement(e); });
 }
 
 QSvgRenderer *NodeFinderSVGConverter::renderer() const
 {
-    return mSvg;
+    return rendererLoader->renderer();
 }
 
 void NodeFinderSVGConverter::clear()
 {
-    for(NodeFinderElementClass &c : elementClasses)
-        c.clear();
+    elementRegistry.clearElements();
+    spatialIndex.clear();
+    geometryCache.clear();
 
     fakeIds.clear();
     fakeIds.squeeze();
@@ -88,20 +95,36 @@ bool NodeFinderSVGConverter::loadXML(QIODevice *dev)
     }
 
     //Create missing items and mirror data
+    //Items are indexed by hash so merging is linear in items count.
+    //Indexes by name are not updated when a name is cleared or changed,
+    //so entries are checked against current name before use.
+    QMultiHash<QChar, int> labelsByLetter;
+    QMultiHash<QString, int> labelsByText;
+    labelsByLetter.reserve(m_plan.labels.size() + m_xmlPlan.labels.size());
+    labelsByText.reserve(m_plan.labels.size() + m_xmlPlan.labels.size());
+    for(int i = 0; i < m_plan.labels.size(); i++)
+    {
+        const ssplib::LabelItem& item = m_plan.labels.at(i);
+        labelsByLetter.insert(item.gateLetter, i);
+        labelsByText.insert(item.labelText, i);
+    }
+
     for(const ssplib::LabelItem& gate : std::as_const(m_xmlPlan.labels))
     {
         bool found = false;
-        for(int i = 0; i < m_plan.labels.size(); i++)
+        for(auto it = labelsByLetter.constFind(gate.gateLetter); it != labelsByLetter.cend() && it.key() == gate.gateLetter; ++it)
         {
-            ssplib::LabelItem& item = m_plan.labels[i];
-            if(gate.gateLetter == item.gateLetter)
-            {
-                //Found, merge info
-                found = true;
-                item.gateOutTrkCount = gate.gateOutTrkCount;
-                item.gateSide = gate.gateSide;
-            }
-            else if(gate.labelText == item.labelText)
+            //Found, merge info
+            found = true;
+            ssplib::LabelItem& item = m_plan.labels[it.value()];
+            item.gateOutTrkCount = gate.gateOutTrkCount;
+            item.gateSide = gate.gateSide;
+        }
+
+        for(auto it = labelsByText.constFind(gate.labelText); it != labelsByText.cend() && it.key() == gate.labelText; ++it)
+        {
+            ssplib::LabelItem& item = m_plan.labels[it.value()];
+            if(item.gateLetter != gate.gateLetter && item.labelText == gate.labelText)
             {
                 //Clear name because it's duplicate
                 item.labelText.clear();
@@ -111,45 +134,72 @@ bool NodeFinderSVGConverter::loadXML(QIODevice *dev)
         if(!found)
         {
             //Item was missing, add it
+            labelsByLetter.insert(gate.gateLetter, m_plan.labels.size());
+            labelsByText.insert(gate.labelText, m_plan.labels.size());
             m_plan.labels.append(gate);
         }
     }
 
+    QMultiHash<int, int> tracksByPos;
+    QMultiHash<QString, int> tracksByName;
+    tracksByPos.reserve(m_plan.platforms.size() + m_xmlPlan.platforms.size());
+    tracksByName.reserve(m_plan.platforms.size() + m_xmlPlan.platforms.size());
+    for(int i = 0; i < m_plan.platforms.size(); i++)
+    {
+        const ssplib::TrackItem& item = m_plan.platforms.at(i);
+        tracksByPos.insert(item.trackPos, i);
+        tracksByName.insert(item.trackName, i);
+    }
+
     for(const ssplib::TrackItem& track : std::as_const(m_xmlPlan.platforms))
     {
-        bool found = false;
-        for(int i = 0; i < m_plan.platforms.size(); i++)
+        for(auto it = tracksByName.constFind(track.trackName); it != tracksByName.cend() && it.key() == track.trackName; ++it)
         {
-            ssplib::TrackItem& item = m_plan.platforms[i];
-            if(track.trackPos == item.trackPos)
-            {
-                //Found, merge info
-                found = true;
-                item.trackName = track.trackName;
-            }
-            else if(track.trackName == item.trackName)
+            ssplib::TrackItem& item = m_plan.platforms[it.value()];
+            if(item.trackPos != track.trackPos && item.trackName == track.trackName)
             {
                 //Clear name because it's duplicate
                 item.trackName.clear();
             }
         }
 
+        bool found = false;
+        for(auto it = tracksByPos.constFind(track.trackPos); it != tracksByPos.cend() && it.key() == track.trackPos; ++it)
+        {
+            //Found, merge info
+            found = true;
+            ssplib::TrackItem& item = m_plan.platforms[it.value()];
+            if(item.trackName != track.trackName)
+            {
+                item.trackName = track.trackName;
+                tracksByName.insert(item.trackName, it.value());
+            }
+        }
+
         if(!found)
         {
             //Item was missing, add it
+            tracksByPos.insert(track.trackPos, m_plan.platforms.size());
+            tracksByName.insert(track.trackName, m_plan.platforms.size());
             m_plan.platforms.append(track);
         }
     }
 
+    QMultiHash<quint64, int> connectionsByKey;
+    connectionsByKey.reserve(m_plan.trackConnections.size() + m_xmlPlan.trackConnections.size());
+    for(int i = 0; i < m_plan.trackConnections.size(); i++)
+        connectionsByKey.insert(m_plan.trackConnections.at(i).info.namesKey(), i);
+
     for(const ssplib::TrackConnectionItem& track : std::as_const(m_xmlPlan.trackConnections))
     {
+        const quint64 key = track.info.namesKey();
+
         bool found = false;
-        for(int i = 0; i < m_plan.trackConnections.size(); i++)
+        for(auto it = connectionsByKey.constFind(key); it != connectionsByKey.cend() && it.key() == key; ++it)
         {
-            ssplib::TrackConnectionItem& item = m_plan.trackConnections[i];
-            if(track.info.matchNames(item.info))
+            if(track.info.matchNames(m_plan.trackConnections.at(it.value()).info))
             {
-                //Found, merge info
+                //Found
                 found = true;
                 break;
             }
@@ -158,6 +208,7 @@ bool NodeFinderSVGConverter::loadXML(QIODevice *dev)
         if(!found)
         {
             //Item was missing, add it
+            connectionsByKey.insert(key, m_plan.trackConnections.size());
             m_plan.trackConnections.append(track);
         }
     }
@@ -187,8 +238,6 @@ void NodeFinderSVGConverter::clearXML()
 bool NodeFinderSVGConverter::loadDocument(QIODevice *dev)
 {
     //FIXME: error reporting
-    clear();
-
     QXmlStreamReader xml(dev);
     xml.setNamespaceProcessing(false);
 
@@ -199,52 +248,55 @@ bool NodeFinderSVGConverter::loadDocument(QIODevice *dev)
 
 bool NodeFinderSVGConverter::save(QIODevice *dev)
 {
-    const int IndentSize = 1;
-
-    removeFakeIDs();
-
-    //Save contents
-    QTextStream stream(dev);
-    mDoc.save(stream, IndentSize);
-
-    restoreFakeIDs();
-
-    return true;
+    //Generated IDs are skipped while writing, document is not modified
+    NodeFinderSVGWriter writer(mDoc, fakeIds);
+    return writer.write(dev);
 }
 
 void NodeFinderSVGConverter::reloadSVGRenderer()
 {
-    QTemporaryFile file;
-    if(!file.open())
-        return;
+    SSPLIB_TRACE_SCOPE_CAT("NodeFinderSVGConverter::reloadSVGRenderer", "editor");
 
-    if(!save(&file))
-        return;
-
-    file.reset();
+    rendererLoader->loadNow();
+}
 
-    QXmlStreamReader xml(&file);
-    mSvg->load(&xml);
+void NodeFinderSVGConverter::scheduleSVGRendererReload()
+{
+    //Old renderer is kept on screen until new one is ready
+    rendererLoader->scheduleReload();
 }
 
 int NodeFinderSVGConverter::calcDefaultTrackPenWidth()
 {
-    QSize sz = mSvg->viewBox().size();
+    QSize sz = renderer()->viewBox().size();
     int trackPenWidth = qMin(sz.width(), sz.height()) / 100;
     if(trackPenWidth < 2)
         trackPenWidth = 2;
     return trackPenWidth;
 }
 
-void NodeFinderSVGConverter::processElements()
+bool NodeFinderSVGConverter::processElements(ssplib::StationPlan *plan, const ssplib::DOMParser::ProgressCallback &progress)
 {
-    ssplib::DOMParser parser(&mDoc, &m_plan, &m_info);
-    parser.parse();
+    ssplib::DOMParser parser(&mDoc, plan, &m_info);
+    parser.setProgressCallback(progress);
+    if(!parser.parse())
+        return false;
+
+    buildSpatialIndex();
 
     //Sort items
-    std::sort(m_plan.labels.begin(), m_plan.labels.end());
-    std::sort(m_plan.platforms.begin(), m_plan.platforms.end());
-    std::sort(m_plan.trackConnections.begin(), m_plan.trackConnections.end());
+    std::sort(plan->labels.begin(), plan->labels.end());
+    std::sort(plan->platforms.begin(), plan->platforms.end());
+    std::sort(plan->trackConnections.begin(), plan->trackConnections.end());
+    return true;
+}
+
+void NodeFinderSVGConverter::setProcessedPlan(const ssplib::StationPlan &plan)
+{
+    //Keep drawing settings
+    m_plan.labels = plan.labels;
+    m_plan.platforms = plan.platforms;
+    m_plan.trackConnections = plan.trackConnections;
 
     //Refresh models
     labelsModel->refreshModel();
@@ -252,6 +304,55 @@ void NodeFinderSVGConverter::processElements()
     turnoutModel->refreshModel();
 }
 
+NodeFinderElementWalker NodeFinderSVGConverter::walkCandidates(const QStringList &tags, const QRectF &area, const QPointF &refPoint)
+{
+    const QList<NodeFinderSpatialIndex::Entry> candidates = spatialIndex.query(area, elementRegistry.tagIdsFor(tags), refPoint);
+    return NodeFinderElementWalker(candidates, &elementRegistry);
+}
+
+void NodeFinderSVGConverter::updateSpatialIndex(const QDomElement &e)
+{
+    if(!spatialIndex.isBuilt())
+        return; //Will be indexed on build
+
+    NodeFinderElementClass *c = elementRegistry.classForTag(e.tagName());
+    if(!c)
+        return;
+
+    NodeFinderSpatialIndex::Entry entry;
+    entry.tagId = c->getTagId();
+    entry.elemIdx = c->indexOf(e.attribute(ssplib::svg_attr::ID));
+    if(entry.elemIdx < 0 || !calcElementBounds(e, entry.bounds))
+        return;
+
+    spatialIndex.update(entry);
+}
+
+bool NodeFinderSVGConverter::getElementPath(const QDomElement &e, ssplib::ElementPath &out, QRectF *outBounds)
+{
+    NodeFinderGeometryCache::Geometry geom;
+    if(!geometryCache.get(e, geom))
+        return false;
+
+    out.elem = e;
+    out.path = geom.path;
+    out.strokeWidth = geom.strokeWidth;
+    if(outBounds)
+        *outBounds = geom.bounds;
+    return true;
+}
+
+void NodeFinderSVGConverter::invalidateGeometry(const QDomElement &e, bool recursive)
+{
+    geometryCache.invalidate(e, recursive);
+}
+
+void NodeFinderSVGConverter::onElementGeometryChanged(const QDomElement &e)
+{
+    geometryCache.invalidate(e, true);
+    updateSpatialIndex(e);
+}
+
 QDomElement NodeFinderSVGConverter::elementById(const QString &id)
 {
     auto it = m_info.namedElements.constFind(id);
@@ -266,24 +367,6 @@ QDomElement NodeFinderSVGConverter::elementById(const QString &id)
     return QDomElement();
 }
 
-void NodeFinderSVGConverter::removeFakeIDs()
-{
-    //Remove unused generated IDs
-    for(QDomElement& e : fakeIds)
-    {
-        e.removeAttribute(ssplib::svg_attr::ID);
-    }
-}
-
-void NodeFinderSVGConverter::restoreFakeIDs()
-{
-    //Restore generated IDs
-    for(auto it = fakeIds.begin(); it != fakeIds.end(); it++)
-    {
-        it.value().setAttribute(ssplib::svg_attr::ID, it.key());
-    }
-}
-
 IObjectModel *NodeFinderSVGConverter::getModel(EditingModes mode) const
 {
     switch (mode)
@@ -368,58 +451,121 @@ bool NodeFinderSVGConverter::addCurrentElementToItem()
         return false;
 
     ssplib::ElementPath path;
-    path.elem = currentWalker.element();
-    if(!ssplib::utils::convertElementToPath(path.elem, path.path))
+    if(!getElementPath(currentWalker.element(), path))
         return false;
 
-    path.strokeWidth = 0;
-    const QRectF bounds = path.path.boundingRect();
-    if(!ssplib::utils::parseStrokeWidthRecursve(path.elem, bounds, path.strokeWidth))
-        path.strokeWidth = 0;
-
     return model->addElementToItem(path, curItem);
 }
 
 void NodeFinderSVGConverter::renameElement(QDomElement &e, const QString &newId)
 {
-    for(NodeFinderElementClass &c : elementClasses)
+    //Cache is keyed by ID
+    geometryCache.invalidate(e);
+
+    NodeFinderElementClass *c = elementRegistry.classForTag(e.tagName());
+    if(!c)
     {
-        if(c.getTagName() == e.tagName())
-        {
-            c.renameElement(e, newId, this);
-            return;
-        }
+        qWarning() << "Renaming unregistered element";
+        return;
     }
-    qWarning() << "Renaming unregistered element";
+
+    c->renameElement(e, newId, this);
 }
 
 void NodeFinderSVGConverter::storeElement(QDomElement e)
 {
-    for(NodeFinderElementClass &c : elementClasses)
+    NodeFinderElementClass *c = elementRegistry.classForTag(e.tagName());
+    if(c && c->preocessElement(e, this))
+        updateSpatialIndex(e);
+}
+
+void NodeFinderSVGConverter::buildSpatialIndex()
+{
+    QList<NodeFinderSpatialIndex::Entry> entries;
+
+    //Groups are not selectable
+    const int groupTagId = elementRegistry.tagId(ssplib::svg_tags::GroupTag);
+
+    for(int tagId = 0; tagId < elementRegistry.classCount(); tagId++)
     {
-        if(c.preocessElement(e, this))
-            break; //Registered
+        if(tagId == groupTagId)
+            continue;
+
+        const NodeFinderElementClass& c = elementRegistry.classAt(tagId);
+        for(int i = 0; i < c.count(); i++)
+        {
+            NodeFinderSpatialIndex::Entry entry;
+            entry.tagId = tagId;
+            entry.elemIdx = i;
+
+            const QDomElement e = c.elementAt(i);
+            if(e.isNull() || !calcElementBounds(e, entry.bounds))
+                continue;
+
+            entries.append(entry);
+        }
     }
+
+    spatialIndex.build(entries);
+}
+
+bool NodeFinderSVGConverter::calcElementBounds(const QDomElement &e, QRectF &outBounds)
+{
+    NodeFinderGeometryCache::Geometry geom;
+    if(!geometryCache.get(e, geom))
+        return false;
+
+    //Same tolerance used when validating single point selection
+    const double margin = qMax(geom.strokeWidth, double(MinStrokeWidth));
+    outBounds = geom.bounds.adjusted(-margin, -margin, margin, margin);
+    return true;
 }
 
 void NodeFinderSVGConverter::removeElement(QDomElement e, bool *isFakeId)
 {
-    for(NodeFinderElementClass &c : elementClasses)
+    NodeFinderElementClass *c = elementRegistry.classForTag(e.tagName());
+    if(!c)
+        return;
+
+    geometryCache.invalidate(e);
+    c->removeElement(e);
+
+    const QString oldId = e.attribute(ssplib::svg_attr::ID);
+    if(fakeIds.contains(oldId))
     {
-        if(c.getTagName() == e.tagName())
-        {
-            c.removeElement(e);
+        if(isFakeId)
+            *isFakeId = true;
+    }
+}
 
-            const QString oldId = e.attribute(ssplib::svg_attr::ID);
-            if(fakeIds.contains(oldId))
-            {
-                if(isFakeId)
-                    *isFakeId = true;
-            }
+void NodeFinderSVGConverter::unregisterElement(QDomElement e)
+{
+    removeElement(e);
 
-            return;
-        }
+    const QString id = e.attribute(ssplib::svg_attr::ID);
+    if(id.isEmpty())
+        return;
+
+    fakeIds.remove(id);
+
+    auto it = m_info.namedElements.find(id);
+    if(it != m_info.namedElements.end() && it.value() == e)
+        m_info.namedElements.erase(it);
+}
+
+void NodeFinderSVGConverter::registerElement(QDomElement e, bool isFakeId, bool isNamed)
+{
+    const QString id = e.attribute(ssplib::svg_attr::ID);
+    if(!id.isEmpty())
+    {
+        m_info.reserveId(id);
+        if(isFakeId)
+            fakeIds.insert(id, e);
+        if(isNamed)
+            m_info.namedElements.insert(id, e);
     }
+
+    storeElement(e);
 }
 
 int NodeFinderSVGConverter::getCurItemSubElemIdx() const
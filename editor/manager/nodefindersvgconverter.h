@@ -6,11 +6,14 @@
 
 #include <QHash>
 
-#include "nodefinderelementclass.h"
+#include "nodefinderelementregistry.h"
 #include "nodefinderelementwalker.h"
+#include "nodefinderspatialindex.h"
+#include "nodefindergeometrycache.h"
 
 #include <ssplib/itemtypes.h>
 #include <ssplib/parsing/editinginfo.h>
+#include <ssplib/parsing/domparser.h>
 #include <ssplib/stationplan.h>
 
 #include "utils/nodefindereditingmodes.h"
@@ -23,6 +26,8 @@ class NodeFinderTurnoutModel;
 
 class IObjectModel;
 
+class NodeFinderRendererLoader;
+
 class QSvgRenderer;
 class QIODevice;
 
@@ -41,18 +46,24 @@ public:
     bool loadXML(QIODevice *dev);
     void clearXML();
 
+    //Call clear() first, can run in a worker thread
     bool loadDocument(QIODevice *dev);
     bool save(QIODevice *dev);
     void reloadSVGRenderer();
+    void scheduleSVGRendererReload();
+    inline NodeFinderRendererLoader *getRendererLoader() const { return rendererLoader; }
 
     int calcDefaultTrackPenWidth();
 
-    void processElements();
+    //Parse loaded document into plan, can run in a worker thread
+    //Returns false if stopped by progress callback
+    bool processElements(ssplib::StationPlan *plan,
+                         const ssplib::DOMParser::ProgressCallback& progress = ssplib::DOMParser::ProgressCallback());
 
-    QDomElement elementById(const QString& id);
+    //Show plan parsed by processElements() and refresh models
+    void setProcessedPlan(const ssplib::StationPlan& plan);
 
-    void removeFakeIDs();
-    void restoreFakeIDs();
+    QDomElement elementById(const QString& id);
 
     IObjectModel *getModel(EditingModes mode) const;
 
@@ -60,9 +71,27 @@ public:
 
     inline NodeFinderElementWalker walkElements(const QStringList& tagOrder)
     {
-        return NodeFinderElementWalker(tagOrder, elementClasses);
+        return NodeFinderElementWalker(elementRegistry.tagIdsFor(tagOrder), &elementRegistry);
     }
 
+    //Walk only elements near area, nearest to refPoint first
+    NodeFinderElementWalker walkCandidates(const QStringList& tags, const QRectF& area, const QPointF& refPoint);
+
+    //Call after changing element geometry
+    void updateSpatialIndex(const QDomElement &e);
+
+    //Cached path and stroke width, returns false if element cannot be converted
+    bool getElementPath(const QDomElement &e, ssplib::ElementPath &out, QRectF *outBounds = nullptr);
+
+    //Call when element or ancestor style, transform or geometry changes
+    void invalidateGeometry(const QDomElement &e, bool recursive = false);
+
+    //Invalidate cached geometry of element and children and update spatial index
+    void onElementGeometryChanged(const QDomElement &e);
+
+    //Minimum hit test tolerance around elements
+    static constexpr qreal MinStrokeWidth = 5;
+
     void removeCurrentSubElementFromItem();
     bool addCurrentElementToItem();
 
@@ -81,29 +110,41 @@ private:
 
     void storeElement(QDomElement e);
 
+    void buildSpatialIndex();
+    bool calcElementBounds(const QDomElement &e, QRectF &outBounds);
+
     void removeElement(QDomElement e, bool *isFakeId = nullptr);
 
+    //Used by undo journal to restore element ID registration exactly
+    void unregisterElement(QDomElement e);
+    void registerElement(QDomElement e, bool isFakeId, bool isNamed);
+
     inline void registerClass(const QString& tagName)
     {
-        NodeFinderElementClass c(tagName, tagName + '_');
-        elementClasses.insert(tagName, c);
+        elementRegistry.registerClass(tagName, tagName + '_');
     }
 
 private:
     friend class NodeFinderElementClass;
     friend class NodeFinderMgr;
     friend class ElementSplitterHelper;
+    friend class NodeFinderSuggestionEngine;
+    friend class NodeFinderDocumentLoader;
+    friend class NodeFinderSelectionPreview;
+    friend struct NodeFinderElementState;
 
     NodeFinderMgr *nodeMgr;
 
-    QSvgRenderer *mSvg;
+    NodeFinderRendererLoader *rendererLoader;
 
     QDomDocument mDoc;
     ssplib::StationPlan m_plan;
     ssplib::StationPlan m_xmlPlan;
     ssplib::EditingInfo m_info;
 
-    QHash<QString, NodeFinderElementClass> elementClasses;
+    NodeFinderElementRegistry elementRegistry;
+    NodeFinderSpatialIndex spatialIndex;
+    NodeFinderGeometryCache geometryCache;
 
     NodeFinderElementClass::ElementHash fakeIds;
 
@@ -0,0 +1,155 @@
+#include "nodefindersvgwriter.h"
+
+#include <ssplib/utils/svg_constants.h>
+
+#include <QDomNamedNodeMap>
+
+static constexpr qint64 BufferFlushSize = 1024 * 1024;
+static constexpr int IndentSize = 1;
+
+NodeFinderSVGWriter::NodeFinderSVGWriter(const QDomDocument &doc, const NodeFinderElementClass::ElementHash &fakeIds) :
+    m_doc(doc),
+    m_fakeIds(fakeIds),
+    m_dev(nullptr),
+    m_ok(true)
+{
+
+}
+
+bool NodeFinderSVGWriter::write(QIODevice *dev)
+{
+    m_dev = dev;
+    m_ok = true;
+
+    m_buffer.buffer().reserve(BufferFlushSize * 2);
+    m_buffer.open(QIODevice::WriteOnly);
+
+    m_xml.setDevice(&m_buffer);
+    m_xml.setAutoFormatting(true);
+    m_xml.setAutoFormattingIndent(IndentSize);
+
+    //Document type is not a child node, write it after xml declaration
+    bool docTypeWritten = false;
+    for(QDomNode n = m_doc.firstChild(); !n.isNull() && m_ok; n = n.nextSibling())
+    {
+        const bool isXmlDecl = n.isProcessingInstruction()
+                && n.toProcessingInstruction().target() == QLatin1String("xml");
+        if(!docTypeWritten && !isXmlDecl)
+        {
+            writeDocumentType(m_doc.doctype());
+            docTypeWritten = true;
+        }
+
+        writeNode(n);
+    }
+
+    if(!docTypeWritten)
+        writeDocumentType(m_doc.doctype());
+
+    m_xml.writeEndDocument();
+    m_xml.setDevice(nullptr);
+
+    flushBuffer(true);
+    m_buffer.close();
+    m_buffer.buffer().clear();
+
+    m_dev = nullptr;
+    return m_ok && !m_xml.hasError();
+}
+
+void NodeFinderSVGWriter::writeNode(const QDomNode &n)
+{
+    switch (n.nodeType())
+    {
+    case QDomNode::ElementNode:
+        writeElement(n.toElement());
+        break;
+    case QDomNode::TextNode:
+        m_xml.writeCharacters(n.nodeValue());
+        break;
+    case QDomNode::CDATASectionNode:
+        m_xml.writeCDATA(n.nodeValue());
+        break;
+    case QDomNode::CommentNode:
+        m_xml.writeComment(n.nodeValue());
+        break;
+    case QDomNode::ProcessingInstructionNode:
+    {
+        const QDomProcessingInstruction pi = n.toProcessingInstruction();
+        m_xml.writeProcessingInstruction(pi.target(), pi.data());
+        break;
+    }
+    case QDomNode::EntityReferenceNode:
+        m_xml.writeEntityReference(n.nodeName());
+        break;
+    default:
+        break;
+    }
+}
+
+void NodeFinderSVGWriter::writeElement(const QDomElement &e)
+{
+    m_xml.writeStartElement(e.tagName());
+
+    const QDomNamedNodeMap attrs = e.attributes();
+    for(int i = 0; i < attrs.length(); i++)
+    {
+        const QDomAttr attr = attrs.item(i).toAttr();
+        if(attr.name() == ssplib::svg_attr::ID)
+        {
+            //Skip generated IDs
+            auto it = m_fakeIds.constFind(attr.value());
+            if(it != m_fakeIds.constEnd() && it.value() == e)
+                continue;
+        }
+
+        m_xml.writeAttribute(attr.name(), attr.value());
+    }
+
+    for(QDomNode n = e.firstChild(); !n.isNull() && m_ok; n = n.nextSibling())
+        writeNode(n);
+
+    m_xml.writeEndElement();
+
+    flushBuffer(false);
+}
+
+void NodeFinderSVGWriter::writeDocumentType(const QDomDocumentType &docType)
+{
+    if(docType.isNull() || docType.name().isEmpty())
+        return;
+
+    QString dtd = QLatin1String("<!DOCTYPE ") + docType.name();
+    if(!docType.publicId().isEmpty())
+    {
+        dtd += QLatin1String(" PUBLIC \"") + docType.publicId() + QLatin1Char('"');
+        if(!docType.systemId().isEmpty())
+            dtd += QLatin1String(" \"") + docType.systemId() + QLatin1Char('"');
+    }
+    else if(!docType.systemId().isEmpty())
+    {
+        dtd += QLatin1String(" SYSTEM \"") + docType.systemId() + QLatin1Char('"');
+    }
+
+    if(!docType.internalSubset().isEmpty())
+        dtd += QLatin1String(" [") + docType.internalSubset() + QLatin1Char(']');
+
+    dtd += QLatin1Char('>');
+    m_xml.writeDTD(dtd);
+}
+
+bool NodeFinderSVGWriter::flushBuffer(bool force)
+{
+    QByteArray& data = m_buffer.buffer();
+    if(!m_ok || (!force && data.size() < BufferFlushSize))
+        return m_ok;
+
+    if(m_dev->write(data) != data.size())
+        m_ok = false;
+
+    //Reuse allocated buffer
+    data.resize(0);
+    m_buffer.seek(0);
+
+    return m_ok;
+}
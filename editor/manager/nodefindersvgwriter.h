@@ -0,0 +1,39 @@
+#ifndef NODEFINDERSVGWRITER_H
+#define NODEFINDERSVGWRITER_H
+
+#include <QDomDocument>
+#include <QBuffer>
+#include <QXmlStreamWriter>
+
+#include "nodefinderelementclass.h"
+
+class QIODevice;
+
+//Serializes SVG document without generated IDs
+//Document is only read so it can be saved while still in use.
+//Output is collected in a buffer and written to device in large chunks.
+class NodeFinderSVGWriter
+{
+public:
+    NodeFinderSVGWriter(const QDomDocument& doc, const NodeFinderElementClass::ElementHash& fakeIds);
+
+    bool write(QIODevice *dev);
+
+private:
+    void writeNode(const QDomNode& n);
+    void writeElement(const QDomElement& e);
+    void writeDocumentType(const QDomDocumentType& docType);
+
+    bool flushBuffer(bool force);
+
+private:
+    const QDomDocument& m_doc;
+    const NodeFinderElementClass::ElementHash& m_fakeIds;
+
+    QIODevice *m_dev;
+    QBuffer m_buffer;
+    QXmlStreamWriter m_xml;
+    bool m_ok;
+};
+
+#endif // NODEFINDERSVGWRITER_H
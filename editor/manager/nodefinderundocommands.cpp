@@ -0,0 +1,149 @@
+#include "nodefinderundocommands.h"
+
+#include "nodefindersvgconverter.h"
+
+#include <ssplib/utils/svg_constants.h>
+
+#include <QDomNamedNodeMap>
+
+//Attributes which change rendering or geometry of element and its children
+static bool isGeometryAttribute(const QString& name)
+{
+    static const QStringList geometryAttrs{
+        "d", "points",
+        "x", "x1", "x2",
+        "y", "y1", "y2",
+        "height", "width",
+        "style", "stroke-width", "transform"
+    };
+    return geometryAttrs.contains(name);
+}
+
+NodeFinderElementState NodeFinderElementState::capture(NodeFinderSVGConverter *conv, const QDomElement &e)
+{
+    NodeFinderElementState st;
+    st.tagName = e.tagName();
+
+    const QDomNamedNodeMap attrs = e.attributes();
+    st.attributes.reserve(attrs.length());
+    for(int i = 0; i < attrs.length(); i++)
+    {
+        const QDomAttr attr = attrs.item(i).toAttr();
+        st.attributes.append({attr.name(), attr.value()});
+    }
+
+    const QString id = e.attribute(ssplib::svg_attr::ID);
+    if(!id.isEmpty())
+    {
+        st.isFakeId = conv->fakeIds.contains(id);
+        st.isNamed = conv->m_info.namedElements.contains(id);
+    }
+
+    return st;
+}
+
+void NodeFinderElementState::apply(NodeFinderSVGConverter *conv, QDomElement e) const
+{
+    conv->unregisterElement(e);
+
+    e.setTagName(tagName);
+
+    //Replace all attributes
+    const QDomNamedNodeMap attrs = e.attributes();
+    QStringList oldNames;
+    oldNames.reserve(attrs.length());
+    for(int i = 0; i < attrs.length(); i++)
+        oldNames.append(attrs.item(i).nodeName());
+
+    for(const QString& name : std::as_const(oldNames))
+        e.removeAttribute(name);
+
+    for(const auto& attr : attributes)
+        e.setAttribute(attr.first, attr.second);
+
+    conv->registerElement(e, isFakeId, isNamed);
+    conv->onElementGeometryChanged(e);
+}
+
+NodeFinderAttributeCommand::NodeFinderAttributeCommand(NodeFinderSVGConverter *conv, const QDomElement &e,
+                                                       const QString &name, const QString &value, bool remove,
+                                                       QUndoCommand *parent) :
+    QUndoCommand(parent),
+    m_conv(conv),
+    m_elem(e),
+    m_name(name),
+    m_newValue(value),
+    m_hasNewValue(!remove)
+{
+    m_hadOldValue = e.hasAttribute(name);
+    m_oldValue = e.attribute(name);
+}
+
+void NodeFinderAttributeCommand::undo()
+{
+    setValue(m_hadOldValue, m_oldValue);
+}
+
+void NodeFinderAttributeCommand::redo()
+{
+    setValue(m_hasNewValue, m_newValue);
+}
+
+void NodeFinderAttributeCommand::setValue(bool hasValue, const QString &value)
+{
+    if(hasValue)
+        m_elem.setAttribute(m_name, value);
+    else
+        m_elem.removeAttribute(m_name);
+
+    if(isGeometryAttribute(m_name))
+    {
+        m_conv->onElementGeometryChanged(m_elem);
+        m_conv->scheduleSVGRendererReload();
+    }
+}
+
+NodeFinderSplitCommand::NodeFinderSplitCommand(NodeFinderSVGConverter *conv, const QDomElement &origElem,
+                                               const NodeFinderElementState &before, const NodeFinderElementState &after,
+                                               const QDomElement &newElem, const NodeFinderElementState &newState,
+                                               QUndoCommand *parent) :
+    QUndoCommand(parent),
+    m_conv(conv),
+    m_origElem(origElem),
+    m_newElem(newElem),
+    m_before(before),
+    m_after(after),
+    m_newState(newState),
+    m_firstRedo(true)
+{
+
+}
+
+void NodeFinderSplitCommand::undo()
+{
+    //Remove new element, it is kept alive by this command for redo
+    m_conv->unregisterElement(m_newElem);
+    m_newElem.parentNode().removeChild(m_newElem);
+
+    m_before.apply(m_conv, m_origElem);
+
+    m_conv->scheduleSVGRendererReload();
+}
+
+void NodeFinderSplitCommand::redo()
+{
+    if(m_firstRedo)
+    {
+        //Already applied by ElementSplitterHelper
+        m_firstRedo = false;
+        return;
+    }
+
+    m_after.apply(m_conv, m_origElem);
+
+    //Insert before registering so stroke width can be resolved from parents
+    m_origElem.parentNode().insertAfter(m_newElem, m_origElem);
+    m_newState.apply(m_conv, m_newElem);
+
+    m_conv->scheduleSVGRendererReload();
+}
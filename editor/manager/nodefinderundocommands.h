@@ -0,0 +1,149 @@
+#ifndef NODEFINDERUNDOCOMMANDS_H
+#define NODEFINDERUNDOCOMMANDS_H
+
+#include <QUndoCommand>
+#include <QDomElement>
+#include <QList>
+#include <QPair>
+
+#include "model/iobjectmodel.h"
+
+class NodeFinderSVGConverter;
+
+//Tag, attributes and ID registration of an element, to restore it exactly
+struct NodeFinderElementState
+{
+    QString tagName;
+    QList<QPair<QString, QString>> attributes;
+    bool isFakeId = false;
+    bool isNamed = false;
+
+    static NodeFinderElementState capture(NodeFinderSVGConverter *conv, const QDomElement& e);
+    void apply(NodeFinderSVGConverter *conv, QDomElement e) const;
+};
+
+//Set or remove a single attribute
+class NodeFinderAttributeCommand : public QUndoCommand
+{
+public:
+    NodeFinderAttributeCommand(NodeFinderSVGConverter *conv, const QDomElement& e,
+                               const QString& name, const QString& value, bool remove,
+                               QUndoCommand *parent = nullptr);
+
+    void undo() override;
+    void redo() override;
+
+private:
+    void setValue(bool hasValue, const QString& value);
+
+private:
+    NodeFinderSVGConverter *m_conv;
+    QDomElement m_elem;
+    QString m_name;
+    QString m_oldValue;
+    QString m_newValue;
+    bool m_hadOldValue;
+    bool m_hasNewValue;
+};
+
+//Element split in two, original element might also be converted to path
+//Split is already applied when command is created so first redo is skipped
+class NodeFinderSplitCommand : public QUndoCommand
+{
+public:
+    NodeFinderSplitCommand(NodeFinderSVGConverter *conv, const QDomElement& origElem,
+                           const NodeFinderElementState& before, const NodeFinderElementState& after,
+                           const QDomElement& newElem, const NodeFinderElementState& newState,
+                           QUndoCommand *parent = nullptr);
+
+    void undo() override;
+    void redo() override;
+
+private:
+    NodeFinderSVGConverter *m_conv;
+    QDomElement m_origElem;
+    QDomElement m_newElem;
+    NodeFinderElementState m_before;
+    NodeFinderElementState m_after;
+    NodeFinderElementState m_newState;
+    bool m_firstRedo;
+};
+
+//Insert, remove or replace a single item of a plan list
+//Replaced items can move to a different row to keep list sorted
+template <typename Item>
+class NodeFinderItemCommand : public QUndoCommand
+{
+public:
+    NodeFinderItemCommand(IObjectModel *model, QList<Item> *list,
+                          int row, bool hasOldItem, const Item& oldItem,
+                          int rowAfter, bool hasNewItem, const Item& newItem,
+                          QUndoCommand *parent = nullptr) :
+        QUndoCommand(parent),
+        m_model(model),
+        m_list(list),
+        m_oldItem(oldItem),
+        m_newItem(newItem),
+        m_row(row),
+        m_rowAfter(rowAfter),
+        m_hasOldItem(hasOldItem),
+        m_hasNewItem(hasNewItem)
+    {
+    }
+
+    void undo() override
+    {
+        apply(m_rowAfter, m_hasNewItem, m_row, m_hasOldItem, m_oldItem);
+    }
+
+    void redo() override
+    {
+        apply(m_row, m_hasOldItem, m_rowAfter, m_hasNewItem, m_newItem);
+    }
+
+private:
+    void apply(int fromRow, bool removeFrom, int toRow, bool insertTo, const Item& item)
+    {
+        if(removeFrom && insertTo)
+        {
+            if(fromRow == toRow)
+            {
+                (*m_list)[toRow] = item;
+            }
+            else
+            {
+                m_model->beginItemMove(fromRow, toRow);
+                m_list->removeAt(fromRow);
+                m_list->insert(toRow, item);
+                m_model->endItemMove();
+            }
+            m_model->itemChanged(toRow);
+        }
+        else if(insertTo)
+        {
+            m_model->beginItemInsert(toRow);
+            m_list->insert(toRow, item);
+            m_model->endItemInsert();
+        }
+        else if(removeFrom)
+        {
+            m_model->beginItemRemove(fromRow);
+            m_list->removeAt(fromRow);
+            m_model->endItemRemove();
+        }
+
+        m_model->onItemsChanged();
+    }
+
+private:
+    IObjectModel *m_model;
+    QList<Item> *m_list;
+    Item m_oldItem;
+    Item m_newItem;
+    int m_row;
+    int m_rowAfter;
+    bool m_hasOldItem;
+    bool m_hasNewItem;
+};
+
+#endif // NODEFINDERUNDOCOMMANDS_H
@@ -0,0 +1,99 @@
+#include "nodefinderundojournal.h"
+
+#include "nodefindermgr.h"
+#include "nodefindersvgconverter.h"
+
+#include <QDebug>
+
+NodeFinderUndoJournal::NodeFinderUndoJournal(NodeFinderMgr *mgr, NodeFinderSVGConverter *conv) :
+    QObject(mgr),
+    nodeMgr(mgr),
+    m_conv(conv),
+    m_replaying(false)
+{
+    m_stack = new QUndoStack(this);
+}
+
+void NodeFinderUndoJournal::beginMacro(const QString &text)
+{
+    if(m_replaying)
+        return;
+    m_stack->beginMacro(text);
+}
+
+void NodeFinderUndoJournal::endMacro()
+{
+    if(m_replaying)
+        return;
+    m_stack->endMacro();
+}
+
+void NodeFinderUndoJournal::clear()
+{
+    m_stack->clear();
+}
+
+void NodeFinderUndoJournal::setAttribute(const QDomElement &e, const QString &name, const QString &value)
+{
+    push(new NodeFinderAttributeCommand(m_conv, e, name, value, false));
+}
+
+void NodeFinderUndoJournal::removeAttribute(const QDomElement &e, const QString &name)
+{
+    if(!e.hasAttribute(name))
+        return;
+    push(new NodeFinderAttributeCommand(m_conv, e, name, QString(), true));
+}
+
+void NodeFinderUndoJournal::recordElementSplit(const QDomElement &origElem,
+                                               const NodeFinderElementState &before, const NodeFinderElementState &after,
+                                               const QDomElement &newElem, const NodeFinderElementState &newState)
+{
+    QUndoCommand *cmd = new NodeFinderSplitCommand(m_conv, origElem, before, after, newElem, newState);
+    cmd->setText(tr("Split Element"));
+    push(cmd);
+}
+
+void NodeFinderUndoJournal::undo()
+{
+    if(!m_stack->canUndo())
+        return;
+
+    //Current item pointer would be invalidated
+    nodeMgr->clearCurrentItem();
+
+    m_replaying = true;
+    m_stack->undo();
+    m_replaying = false;
+
+    nodeMgr->requestRepaint(NodeFinderRepaintScheduler::Background);
+}
+
+void NodeFinderUndoJournal::redo()
+{
+    if(!m_stack->canRedo())
+        return;
+
+    //Current item pointer would be invalidated
+    nodeMgr->clearCurrentItem();
+
+    m_replaying = true;
+    m_stack->redo();
+    m_replaying = false;
+
+    nodeMgr->requestRepaint(NodeFinderRepaintScheduler::Background);
+}
+
+void NodeFinderUndoJournal::push(QUndoCommand *cmd)
+{
+    if(m_replaying)
+    {
+        //Should not happen, apply without recording
+        qWarning() << "NodeFinderUndoJournal: recording while replaying";
+        cmd->redo();
+        delete cmd;
+        return;
+    }
+
+    m_stack->push(cmd);
+}
@@ -0,0 +1,100 @@
+#ifndef NODEFINDERUNDOJOURNAL_H
+#define NODEFINDERUNDOJOURNAL_H
+
+#include <QObject>
+#include <QUndoStack>
+
+#include "nodefinderundocommands.h"
+
+class NodeFinderMgr;
+class NodeFinderSVGConverter;
+
+//Undo history of editing operations
+//Each operation records only what it changes (single attributes, single items,
+//split elements) so memory grows with history and not with document size.
+//Recording functions apply the change and push it on the stack.
+class NodeFinderUndoJournal : public QObject
+{
+    Q_OBJECT
+public:
+    explicit NodeFinderUndoJournal(NodeFinderMgr *mgr, NodeFinderSVGConverter *conv);
+
+    inline QUndoStack *undoStack() const { return m_stack; }
+
+    //True while undoing or redoing, changes are not recorded
+    inline bool isReplaying() const { return m_replaying; }
+
+    //Group following operations in one undo step
+    void beginMacro(const QString& text);
+    void endMacro();
+
+    void clear();
+
+    //DOM operations
+    void setAttribute(const QDomElement& e, const QString& name, const QString& value);
+    void removeAttribute(const QDomElement& e, const QString& name);
+
+    //Split already applied by ElementSplitterHelper
+    void recordElementSplit(const QDomElement& origElem,
+                            const NodeFinderElementState& before, const NodeFinderElementState& after,
+                            const QDomElement& newElem, const NodeFinderElementState& newState);
+
+    //Item operations
+    template <typename Item>
+    void insertItem(IObjectModel *model, QList<Item> *list, int row, const Item& item)
+    {
+        push(new NodeFinderItemCommand<Item>(model, list,
+                                             row, false, Item(),
+                                             row, true, item));
+    }
+
+    template <typename Item>
+    void removeItem(IObjectModel *model, QList<Item> *list, int row)
+    {
+        push(new NodeFinderItemCommand<Item>(model, list,
+                                             row, true, list->at(row),
+                                             row, false, Item()));
+    }
+
+    //Item stays in same row, use when sorting keys are unchanged
+    template <typename Item>
+    void updateItem(IObjectModel *model, QList<Item> *list, int row, const Item& item)
+    {
+        push(new NodeFinderItemCommand<Item>(model, list,
+                                             row, true, list->at(row),
+                                             row, true, item));
+    }
+
+    //Item is moved to keep list sorted, returns new row
+    template <typename Item>
+    int replaceItem(IObjectModel *model, QList<Item> *list, int row, const Item& item)
+    {
+        //Position among other items, without replaced one
+        int rowAfter = 0;
+        for(int i = 0; i < list->size(); i++)
+        {
+            if(i != row && !(item < list->at(i)))
+                rowAfter++;
+        }
+
+        push(new NodeFinderItemCommand<Item>(model, list,
+                                             row, true, list->at(row),
+                                             rowAfter, true, item));
+        return rowAfter;
+    }
+
+public slots:
+    void undo();
+    void redo();
+
+private:
+    void push(QUndoCommand *cmd);
+
+private:
+    NodeFinderMgr *nodeMgr;
+    NodeFinderSVGConverter *m_conv;
+    QUndoStack *m_stack;
+    bool m_replaying;
+};
+
+#endif // NODEFINDERUNDOJOURNAL_H
@@ -9,6 +9,7 @@ IObjectModel::IObjectModel(QObject *parent) :
 void IObjectModel::refreshModel()
 {
     beginResetModel();
+    rebuildLookups();
     endResetModel();
 }
 
@@ -36,3 +37,24 @@ bool IObjectModel::removeElementFromItem(ssplib::ItemBase *item, int pos)
 {
     return false;
 }
+
+bool IObjectModel::beginItemMove(int from, int to)
+{
+    //Destination is row index before removal
+    return beginMoveRows(QModelIndex(), from, from, QModelIndex(), to > from ? to + 1 : to);
+}
+
+void IObjectModel::itemChanged(int row)
+{
+    emit dataChanged(index(row, 0), index(row, columnCount() - 1));
+}
+
+void IObjectModel::onItemsChanged()
+{
+
+}
+
+void IObjectModel::rebuildLookups()
+{
+
+}
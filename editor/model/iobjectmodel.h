@@ -25,6 +25,18 @@ public:
     virtual bool addElementToItem(ssplib::ElementPath &p, ssplib::ItemBase *item);
     virtual bool removeElementFromItem(ssplib::ItemBase *item, int pos);
 
+    //Used by undo journal to notify views around item list changes
+    inline void beginItemInsert(int row) { beginInsertRows(QModelIndex(), row, row); }
+    inline void endItemInsert() { endInsertRows(); }
+    inline void beginItemRemove(int row) { beginRemoveRows(QModelIndex(), row, row); }
+    inline void endItemRemove() { endRemoveRows(); }
+    bool beginItemMove(int from, int to);
+    inline void endItemMove() { endMoveRows(); }
+    void itemChanged(int row);
+
+    //Called after items changed, to update dependent models
+    virtual void onItemsChanged();
+
     //Common translations
     static inline QString getTrackSideName(ssplib::Side s)
     {
@@ -49,6 +61,10 @@ public:
                           "Cannot remove item loaded from XML.\n"
                           "Unload XML to remove this item.");
 
+protected:
+    //Called by refreshModel() to rebuild cached lookup tables
+    virtual void rebuildLookups();
+
 signals:
     void itemRemoved(int row);
     void errorOccurred(const QString& msg);
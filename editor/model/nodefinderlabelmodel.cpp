@@ -1,6 +1,7 @@
 #include "nodefinderlabelmodel.h"
 
 #include "manager/nodefindermgr.h"
+#include "manager/nodefinderundojournal.h"
 
 #include <ssplib/utils/svg_constants.h>
 
@@ -107,8 +108,9 @@ bool NodeFinderLabelModel::setData(const QModelIndex &idx, const QVariant &value
     if (!idx.isValid())
         return false;
 
-
-    ssplib::LabelItem& item = m_plan->labels[idx.row()];
+    //Edit a copy, changes are applied through undo journal
+    const int row = idx.row();
+    ssplib::LabelItem item = m_plan->labels.at(row);
     const QChar oldGateLetter = item.gateLetter;
 
     if(itemIsInXML(item) && role != Qt::CheckStateRole)
@@ -197,22 +199,24 @@ bool NodeFinderLabelModel::setData(const QModelIndex &idx, const QVariant &value
     }
     }
 
+    NodeFinderUndoJournal *journal = nodeMgr->getJournal();
+    journal->beginMacro(tr("Edit Label"));
+
     if(oldGateLetter != item.gateLetter)
     {
         //Rebuild element attributes
-        for(ssplib::ElementPath &p : item.elements)
+        for(const ssplib::ElementPath &p : std::as_const(item.elements))
         {
             //Rebuild attribute
-            p.elem.setAttribute(ssplib::svg_attr::LabelName, item.gateLetter);
+            journal->setAttribute(p.elem, ssplib::svg_attr::LabelName, item.gateLetter);
         }
     }
 
-    std::sort(m_plan->labels.begin(), m_plan->labels.end());
+    //Keep labels sorted
+    journal->replaceItem(this, &m_plan->labels, row, item);
+    journal->endMacro();
 
-    emit dataChanged(idx, idx);
-    emit nodeMgr->repaintSVG();
-
-    emit labelsChanged();
+    nodeMgr->requestRepaint(NodeFinderRepaintScheduler::Background);
 
     return true;
 }
@@ -238,11 +242,14 @@ bool NodeFinderLabelModel::addElementToItem(ssplib::ElementPath &p, ssplib::Item
     ssplib::LabelItem *ptr = static_cast<ssplib::LabelItem *>(item);
     int row = ptr - m_plan->labels.data(); //Pointer aritmetics
 
-    p.elem.setAttribute(ssplib::svg_attr::LabelName, ptr->gateLetter);
-    item->elements.append(p);
+    ssplib::LabelItem newItem = *ptr;
+    newItem.elements.append(p);
 
-    QModelIndex idx = index(row, 0);
-    emit dataChanged(idx, idx);
+    NodeFinderUndoJournal *journal = nodeMgr->getJournal();
+    journal->beginMacro(tr("Add Label Element"));
+    journal->setAttribute(p.elem, ssplib::svg_attr::LabelName, ptr->gateLetter);
+    journal->updateItem(this, &m_plan->labels, row, newItem);
+    journal->endMacro();
 
     return true;
 }
@@ -255,23 +262,29 @@ bool NodeFinderLabelModel::removeElementFromItem(ssplib::ItemBase *item, int pos
     ssplib::LabelItem *ptr = static_cast<ssplib::LabelItem *>(item);
     int row = ptr - m_plan->labels.data(); //Pointer aritmetics
 
-    ptr->elements[pos].elem.removeAttribute(ssplib::svg_attr::LabelName);
-    ptr->elements.removeAt(pos);
+    ssplib::LabelItem newItem = *ptr;
+    const ssplib::ElementPath elemPath = newItem.elements.takeAt(pos);
 
-    QModelIndex idx = index(row, 0);
-    emit dataChanged(idx, idx);
+    NodeFinderUndoJournal *journal = nodeMgr->getJournal();
+    journal->beginMacro(tr("Remove Label Element"));
+    journal->removeAttribute(elemPath.elem, ssplib::svg_attr::LabelName);
+    journal->updateItem(this, &m_plan->labels, row, newItem);
+    journal->endMacro();
 
     return true;
 }
 
 bool NodeFinderLabelModel::itemIsInXML(const ssplib::LabelItem &item) const
 {
+    return m_xmlGateLetters.contains(item.gateLetter);
+}
+
+void NodeFinderLabelModel::rebuildLookups()
+{
+    m_xmlGateLetters.clear();
+    m_xmlGateLetters.reserve(xmlPlan->labels.size());
     for(const ssplib::LabelItem& gate : std::as_const(xmlPlan->labels))
-    {
-        if(gate.gateLetter == item.gateLetter)
-            return true;
-    }
-    return false;
+        m_xmlGateLetters.insert(gate.gateLetter);
 }
 
 bool NodeFinderLabelModel::addItem()
@@ -282,11 +295,7 @@ bool NodeFinderLabelModel::addItem()
     item.gateLetter = '-';
     item.visible = false;
 
-    beginInsertRows(QModelIndex(), m_plan->labels.size(), m_plan->labels.size());
-    m_plan->labels.append(item);
-    endInsertRows();
-
-    emit labelsChanged();
+    nodeMgr->getJournal()->insertItem(this, &m_plan->labels, m_plan->labels.size(), item);
 
     return true;
 }
@@ -298,23 +307,23 @@ bool NodeFinderLabelModel::removeItem(int row)
 
     nodeMgr->clearCurrentItem();
 
-    ssplib::LabelItem& item = m_plan->labels[row];
+    const ssplib::LabelItem& item = m_plan->labels.at(row);
     if(itemIsInXML(item))
     {
         emit errorOccurred(IObjectModel::tr(errMsgCannotRemWithXML));
         return false;
     }
 
-    for(ssplib::ElementPath& elemPath : item.elements)
+    NodeFinderUndoJournal *journal = nodeMgr->getJournal();
+    journal->beginMacro(tr("Remove Label"));
+
+    for(const ssplib::ElementPath& elemPath : std::as_const(item.elements))
     {
-        elemPath.elem.removeAttribute(ssplib::svg_attr::LabelName);
+        journal->removeAttribute(elemPath.elem, ssplib::svg_attr::LabelName);
     }
 
-    beginRemoveRows(QModelIndex(), row, row);
-    m_plan->labels.removeAt(row);
-    endRemoveRows();
-
-    emit labelsChanged();
+    journal->removeItem(this, &m_plan->labels, row);
+    journal->endMacro();
 
     return true;
 }
@@ -329,3 +338,8 @@ bool NodeFinderLabelModel::editItem(int row)
 
     return true;
 }
+
+void NodeFinderLabelModel::onItemsChanged()
+{
+    emit labelsChanged();
+}
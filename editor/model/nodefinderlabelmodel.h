@@ -4,6 +4,7 @@
 #include "iobjectmodel.h"
 
 #include <QList>
+#include <QSet>
 
 #include <ssplib/itemtypes.h>
 
@@ -50,8 +51,13 @@ public:
     bool addElementToItem(ssplib::ElementPath &p, ssplib::ItemBase *item) override;
     bool removeElementFromItem(ssplib::ItemBase *item, int pos) override;
 
+    void onItemsChanged() override;
+
     bool itemIsInXML(const ssplib::LabelItem &item) const;
 
+protected:
+    void rebuildLookups() override;
+
 signals:
     void labelsChanged();
 
@@ -61,6 +67,9 @@ private:
     NodeFinderMgr *nodeMgr;
     ssplib::StationPlan *m_plan;
     ssplib::StationPlan *xmlPlan;
+
+    //Gate letters of XML labels
+    QSet<QChar> m_xmlGateLetters;
 };
 
 #endif // NODEFINDERLABELMODEL_H
@@ -1,6 +1,7 @@
 #include "nodefinderstationtracksmodel.h"
 
 #include "manager/nodefindermgr.h"
+#include "manager/nodefinderundojournal.h"
 
 #include <ssplib/utils/svg_constants.h>
 #include <ssplib/stationplan.h>
@@ -104,7 +105,9 @@ bool NodeFinderStationTracksModel::setData(const QModelIndex &idx, const QVarian
     if (!idx.isValid())
         return false;
 
-    ssplib::TrackItem& item = m_plan->platforms[idx.row()];
+    //Edit a copy, changes are applied through undo journal
+    const int row = idx.row();
+    ssplib::TrackItem item = m_plan->platforms.at(row);
     const int oldTrackPos = item.trackPos;
 
     if(itemIsInXML(item) && role != Qt::CheckStateRole)
@@ -184,23 +187,25 @@ bool NodeFinderStationTracksModel::setData(const QModelIndex &idx, const QVarian
     }
     }
 
+    NodeFinderUndoJournal *journal = nodeMgr->getJournal();
+    journal->beginMacro(tr("Edit Station Track"));
+
     if(oldTrackPos != item.trackPos)
     {
         //Rebuild element attributes
         const QString trkPosStr = QString::number(item.trackPos);
-        for(ssplib::ElementPath &p : item.elements)
+        for(const ssplib::ElementPath &p : std::as_const(item.elements))
         {
             //Rebuild attribute
-            p.elem.setAttribute(ssplib::svg_attr::TrackPos, trkPosStr);
+            journal->setAttribute(p.elem, ssplib::svg_attr::TrackPos, trkPosStr);
         }
     }
 
-    std::sort(m_plan->platforms.begin(), m_plan->platforms.end());
-
-    emit dataChanged(idx, idx);
-    emit nodeMgr->repaintSVG();
+    //Keep tracks sorted
+    journal->replaceItem(this, &m_plan->platforms, row, item);
+    journal->endMacro();
 
-    emit tracksChanged();
+    nodeMgr->requestRepaint(NodeFinderRepaintScheduler::Background);
 
     return true;
 }
@@ -226,11 +231,14 @@ bool NodeFinderStationTracksModel::addElementToItem(ssplib::ElementPath &p, sspl
     ssplib::TrackItem *ptr = static_cast<ssplib::TrackItem *>(item);
     int row = ptr - m_plan->platforms.data(); //Pointer aritmetics
 
-    p.elem.setAttribute(ssplib::svg_attr::TrackPos, QString::number(ptr->trackPos));
-    item->elements.append(p);
+    ssplib::TrackItem newItem = *ptr;
+    newItem.elements.append(p);
 
-    QModelIndex idx = index(row, 0);
-    emit dataChanged(idx, idx);
+    NodeFinderUndoJournal *journal = nodeMgr->getJournal();
+    journal->beginMacro(tr("Add Station Track Element"));
+    journal->setAttribute(p.elem, ssplib::svg_attr::TrackPos, QString::number(ptr->trackPos));
+    journal->updateItem(this, &m_plan->platforms, row, newItem);
+    journal->endMacro();
 
     return true;
 }
@@ -243,23 +251,28 @@ bool NodeFinderStationTracksModel::removeElementFromItem(ssplib::ItemBase *item,
     ssplib::TrackItem *ptr = static_cast<ssplib::TrackItem *>(item);
     int row = ptr - m_plan->platforms.data(); //Pointer aritmetics
 
-    clearElement(ptr->elements[pos]);
-    ptr->elements.removeAt(pos);
+    ssplib::TrackItem newItem = *ptr;
+    ssplib::ElementPath elemPath = newItem.elements.takeAt(pos);
 
-    QModelIndex idx = index(row, 0);
-    emit dataChanged(idx, idx);
+    nodeMgr->getJournal()->beginMacro(tr("Remove Station Track Element"));
+    clearElement(elemPath);
+    nodeMgr->getJournal()->updateItem(this, &m_plan->platforms, row, newItem);
+    nodeMgr->getJournal()->endMacro();
 
     return true;
 }
 
 bool NodeFinderStationTracksModel::itemIsInXML(const ssplib::TrackItem &item) const
 {
+    return m_xmlTrackPositions.contains(item.trackPos);
+}
+
+void NodeFinderStationTracksModel::rebuildLookups()
+{
+    m_xmlTrackPositions.clear();
+    m_xmlTrackPositions.reserve(xmlPlan->platforms.size());
     for(const ssplib::TrackItem& track : std::as_const(xmlPlan->platforms))
-    {
-        if(track.trackPos == item.trackPos)
-            return true;
-    }
-    return false;
+        m_xmlTrackPositions.insert(track.trackPos);
 }
 
 bool NodeFinderStationTracksModel::addItem()
@@ -277,18 +290,14 @@ bool NodeFinderStationTracksModel::addItem()
     item.trackPos = maxTrackPos + 1;
     item.visible = false;
 
-    beginInsertRows(QModelIndex(), m_plan->platforms.size(), m_plan->platforms.size());
-    m_plan->platforms.append(item);
-    endInsertRows();
-
-    emit tracksChanged();
+    nodeMgr->getJournal()->insertItem(this, &m_plan->platforms, m_plan->platforms.size(), item);
 
     return true;
 }
 
 void NodeFinderStationTracksModel::clearElement(ssplib::ElementPath &elemPath)
 {
-    elemPath.elem.removeAttribute(ssplib::svg_attr::TrackPos);
+    nodeMgr->getJournal()->removeAttribute(elemPath.elem, ssplib::svg_attr::TrackPos);
 }
 
 bool NodeFinderStationTracksModel::removeItem(int row)
@@ -298,21 +307,21 @@ bool NodeFinderStationTracksModel::removeItem(int row)
 
     nodeMgr->clearCurrentItem();
 
-    ssplib::TrackItem& item = m_plan->platforms[row];
+    ssplib::TrackItem item = m_plan->platforms.at(row);
     if(itemIsInXML(item))
     {
         emit errorOccurred(IObjectModel::tr(errMsgCannotRemWithXML));
         return false;
     }
 
+    NodeFinderUndoJournal *journal = nodeMgr->getJournal();
+    journal->beginMacro(tr("Remove Station Track"));
+
     for(ssplib::ElementPath& elemPath : item.elements)
         clearElement(elemPath);
 
-    beginRemoveRows(QModelIndex(), row, row);
-    m_plan->platforms.removeAt(row);
-    endRemoveRows();
-
-    emit tracksChanged();
+    journal->removeItem(this, &m_plan->platforms, row);
+    journal->endMacro();
 
     return true;
 }
@@ -327,3 +336,8 @@ bool NodeFinderStationTracksModel::editItem(int row)
 
     return true;
 }
+
+void NodeFinderStationTracksModel::onItemsChanged()
+{
+    emit tracksChanged();
+}
@@ -4,6 +4,7 @@
 #include "iobjectmodel.h"
 
 #include <QList>
+#include <QSet>
 
 #include <ssplib/itemtypes.h>
 
@@ -52,8 +53,13 @@ public:
     bool addElementToItem(ssplib::ElementPath &p, ssplib::ItemBase *item) override;
     bool removeElementFromItem(ssplib::ItemBase *item, int pos) override;
 
+    void onItemsChanged() override;
+
     bool itemIsInXML(const ssplib::TrackItem &item) const;
 
+protected:
+    void rebuildLookups() override;
+
 signals:
     void tracksChanged();
 
@@ -62,6 +68,9 @@ private:
     NodeFinderMgr *nodeMgr;
     ssplib::StationPlan *m_plan;
     ssplib::StationPlan *xmlPlan;
+
+    //Track positions of XML tracks
+    QSet<int> m_xmlTrackPositions;
 };
 
 #endif // NODEFINDERSTATIONTRACKSMODEL_H
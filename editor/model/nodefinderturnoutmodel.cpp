@@ -1,6 +1,7 @@
 #include "nodefinderturnoutmodel.h"
 
 #include "manager/nodefindermgr.h"
+#include "manager/nodefinderundojournal.h"
 
 #include <ssplib/utils/svg_path_utils.h>
 #include <ssplib/utils/svg_constants.h>
@@ -63,15 +64,9 @@ QVariant NodeFinderTurnoutModel::data(const QModelIndex &idx, int role) const
         {
         case StationTrackCol:
         {
-            for(const ssplib::TrackItem& track : std::as_const(m_plan->platforms))
-            {
-                if(track.trackPos == item.info.stationTrackPos)
-                {
-                    if(track.trackName.isEmpty())
-                        break; //Fallback to position
-                    return track.trackName;
-                }
-            }
+            const QString trackName = m_trackNames.value(item.info.stationTrackPos);
+            if(!trackName.isEmpty())
+                return trackName;
 
             //Fallback to track position
             return QString("#%1").arg(item.info.stationTrackPos);
@@ -127,7 +122,9 @@ bool NodeFinderTurnoutModel::setData(const QModelIndex &idx, const QVariant &val
     if (!idx.isValid())
         return false;
 
-    ssplib::TrackConnectionItem& item = m_plan->trackConnections[idx.row()];
+    //Edit a copy, changes are applied through undo journal
+    const int row = idx.row();
+    ssplib::TrackConnectionItem item = m_plan->trackConnections.at(row);
 
     if(itemIsInXML(item) && role != Qt::CheckStateRole)
     {
@@ -152,15 +149,7 @@ bool NodeFinderTurnoutModel::setData(const QModelIndex &idx, const QVariant &val
                 if(name.isEmpty())
                     return false;
 
-                int pos = -1;
-                for(const ssplib::TrackItem& track : std::as_const(m_plan->platforms))
-                {
-                    if(track.trackName == name)
-                    {
-                        pos = track.trackPos;
-                        break;
-                    }
-                }
+                const int pos = m_trackPositions.value(name, -1);
 
                 if(pos == -1)
                 {
@@ -302,10 +291,13 @@ bool NodeFinderTurnoutModel::setData(const QModelIndex &idx, const QVariant &val
     }
     }
 
+    NodeFinderUndoJournal *journal = nodeMgr->getJournal();
+    journal->beginMacro(tr("Edit Track Connection"));
+
     if(!oldInfo.matchNames(item.info))
     {
         //Rebuild element attributes
-        for(ssplib::ElementPath &p : item.elements)
+        for(const ssplib::ElementPath &p : std::as_const(item.elements))
         {
             //Rebuild attribute
             QList<ssplib::TrackConnectionInfo> infoVec;
@@ -313,14 +305,15 @@ bool NodeFinderTurnoutModel::setData(const QModelIndex &idx, const QVariant &val
             ssplib::TrackConnectionInfo::removeAllNames(infoVec, oldInfo); //Remove old
             infoVec.append(item.info); //Add new
             std::sort(infoVec.begin(), infoVec.end());
-            p.elem.setAttribute(ssplib::svg_attr::TrackConnections, ssplib::utils::trackConnInfoToString(infoVec));
+            journal->setAttribute(p.elem, ssplib::svg_attr::TrackConnections, ssplib::utils::trackConnInfoToString(infoVec));
         }
     }
 
-    std::sort(m_plan->trackConnections.begin(), m_plan->trackConnections.end());
+    //Keep connections sorted
+    journal->replaceItem(this, &m_plan->trackConnections, row, item);
+    journal->endMacro();
 
-    emit dataChanged(idx, idx);
-    emit nodeMgr->repaintSVG();
+    nodeMgr->requestRepaint(NodeFinderRepaintScheduler::Background);
 
     return true;
 }
@@ -352,12 +345,15 @@ bool NodeFinderTurnoutModel::addElementToItem(ssplib::ElementPath &p, ssplib::It
     ssplib::utils::parseTrackConnectionAttribute(p.elem.attribute(ssplib::svg_attr::TrackConnections), infoVec);
     infoVec.append(ptr->info);
     std::sort(infoVec.begin(), infoVec.end());
-    p.elem.setAttribute(ssplib::svg_attr::TrackConnections, ssplib::utils::trackConnInfoToString(infoVec));
 
-    item->elements.append(p);
+    ssplib::TrackConnectionItem newItem = *ptr;
+    newItem.elements.append(p);
 
-    QModelIndex idx = index(row, 0);
-    emit dataChanged(idx, idx);
+    NodeFinderUndoJournal *journal = nodeMgr->getJournal();
+    journal->beginMacro(tr("Add Track Connection Element"));
+    journal->setAttribute(p.elem, ssplib::svg_attr::TrackConnections, ssplib::utils::trackConnInfoToString(infoVec));
+    journal->updateItem(this, &m_plan->trackConnections, row, newItem);
+    journal->endMacro();
 
     return true;
 }
@@ -370,32 +366,66 @@ bool NodeFinderTurnoutModel::removeElementFromItem(ssplib::ItemBase *item, int p
     ssplib::TrackConnectionItem *ptr = static_cast<ssplib::TrackConnectionItem *>(item);
     int row = ptr - m_plan->trackConnections.data(); //Pointer aritmetics
 
-    ssplib::ElementPath p = ptr->elements.takeAt(pos);
+    ssplib::TrackConnectionItem newItem = *ptr;
+    ssplib::ElementPath p = newItem.elements.takeAt(pos);
 
     //Rebuild attribute
     QList<ssplib::TrackConnectionInfo> infoVec;
     ssplib::utils::parseTrackConnectionAttribute(p.elem.attribute(ssplib::svg_attr::TrackConnections), infoVec);
     ssplib::TrackConnectionInfo::removeAllNames(infoVec, ptr->info);
-    p.elem.setAttribute(ssplib::svg_attr::TrackConnections, ssplib::utils::trackConnInfoToString(infoVec));
 
-    QModelIndex idx = index(row, 0);
-    emit dataChanged(idx, idx);
+    NodeFinderUndoJournal *journal = nodeMgr->getJournal();
+    journal->beginMacro(tr("Remove Track Connection Element"));
+    journal->setAttribute(p.elem, ssplib::svg_attr::TrackConnections, ssplib::utils::trackConnInfoToString(infoVec));
+    journal->updateItem(this, &m_plan->trackConnections, row, newItem);
+    journal->endMacro();
 
     return true;
 }
 
 bool NodeFinderTurnoutModel::itemIsInXML(const ssplib::TrackConnectionItem &item) const
 {
-    for(const ssplib::TrackConnectionItem& conn : std::as_const(xmlPlan->trackConnections))
+    const quint64 key = item.info.namesKey();
+    for(auto it = m_xmlConnections.constFind(key); it != m_xmlConnections.cend() && it.key() == key; ++it)
     {
-        if(conn.info.matchNames(item.info))
+        if(xmlPlan->trackConnections.at(it.value()).info.matchNames(item.info))
             return true;
     }
     return false;
 }
 
+void NodeFinderTurnoutModel::rebuildLookups()
+{
+    rebuildTrackLookups();
+
+    m_xmlConnections.clear();
+    m_xmlConnections.reserve(xmlPlan->trackConnections.size());
+    for(int i = 0; i < xmlPlan->trackConnections.size(); i++)
+        m_xmlConnections.insert(xmlPlan->trackConnections.at(i).info.namesKey(), i);
+}
+
+void NodeFinderTurnoutModel::rebuildTrackLookups()
+{
+    m_trackNames.clear();
+    m_trackPositions.clear();
+    m_trackNames.reserve(m_plan->platforms.size());
+    m_trackPositions.reserve(m_plan->platforms.size());
+
+    //First track wins on duplicates
+    for(const ssplib::TrackItem& track : std::as_const(m_plan->platforms))
+    {
+        if(!m_trackNames.contains(track.trackPos))
+            m_trackNames.insert(track.trackPos, track.trackName);
+        if(!m_trackPositions.contains(track.trackName))
+            m_trackPositions.insert(track.trackName, track.trackPos);
+    }
+}
+
 void NodeFinderTurnoutModel::refreshData()
 {
+    //Station tracks or labels changed
+    rebuildTrackLookups();
+
     //Tell view to refresh cells
     QModelIndex first = index(0, 0);
     QModelIndex last = index(m_plan->trackConnections.size() - 1, NCols - 1);
@@ -413,9 +443,7 @@ bool NodeFinderTurnoutModel::addItem()
     item.info.gateTrackPos = 0;
     item.visible = false;
 
-    beginInsertRows(QModelIndex(), m_plan->trackConnections.size(), m_plan->trackConnections.size());
-    m_plan->trackConnections.append(item);
-    endInsertRows();
+    nodeMgr->getJournal()->insertItem(this, &m_plan->trackConnections, m_plan->trackConnections.size(), item);
 
     return true;
 }
@@ -427,25 +455,27 @@ bool NodeFinderTurnoutModel::removeItem(int row)
 
     nodeMgr->clearCurrentItem();
 
-    ssplib::TrackConnectionItem& item = m_plan->trackConnections[row];
+    const ssplib::TrackConnectionItem item = m_plan->trackConnections.at(row);
     if(itemIsInXML(item))
     {
         emit errorOccurred(IObjectModel::tr(errMsgCannotRemWithXML));
         return false;
     }
 
-    for(ssplib::ElementPath& p : item.elements)
+    NodeFinderUndoJournal *journal = nodeMgr->getJournal();
+    journal->beginMacro(tr("Remove Track Connection"));
+
+    for(const ssplib::ElementPath& p : item.elements)
     {
         //Rebuild attribute
         QList<ssplib::TrackConnectionInfo> infoVec;
         ssplib::utils::parseTrackConnectionAttribute(p.elem.attribute(ssplib::svg_attr::TrackConnections), infoVec);
-        ssplib::TrackConnectionInfo::removeAllNames(infoVec, m_plan->trackConnections.at(row).info);
-        p.elem.setAttribute(ssplib::svg_attr::TrackConnections, ssplib::utils::trackConnInfoToString(infoVec));
+        ssplib::TrackConnectionInfo::removeAllNames(infoVec, item.info);
+        journal->setAttribute(p.elem, ssplib::svg_attr::TrackConnections, ssplib::utils::trackConnInfoToString(infoVec));
     }
 
-    beginRemoveRows(QModelIndex(), row, row);
-    m_plan->trackConnections.removeAt(row);
-    endRemoveRows();
+    journal->removeItem(this, &m_plan->trackConnections, row);
+    journal->endMacro();
 
     return true;
 }
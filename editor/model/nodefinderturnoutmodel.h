@@ -4,6 +4,7 @@
 #include "iobjectmodel.h"
 
 #include <QList>
+#include <QHash>
 
 #include <ssplib/itemtypes.h>
 
@@ -55,11 +56,24 @@ public:
 public slots:
     void refreshData();
 
+protected:
+    void rebuildLookups() override;
+
+private:
+    void rebuildTrackLookups();
+
 private:
     friend class NodeFinderSVGWidget;
     NodeFinderMgr *nodeMgr;
     ssplib::StationPlan *m_plan;
     ssplib::StationPlan *xmlPlan;
+
+    //Station track names, rebuilt when tracks change
+    QHash<int, QString> m_trackNames;
+    QHash<QString, int> m_trackPositions;
+
+    //XML connections by TrackConnectionInfo::namesKey()
+    QMultiHash<quint64, int> m_xmlConnections;
 };
 
 #endif // NODEFINDERTURNOUTMODEL_H
@@ -5,6 +5,7 @@
 enum class EditingModes
 {
     NoSVGLoaded = 0,
+    LoadingSVG,
     NoEditing,
     LabelEditing,
     StationTrackEditing,
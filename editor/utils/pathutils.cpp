@@ -1,13 +1,38 @@
 #include "pathutils.h"
 
+#include <QList>
+
+#include <algorithm>
 
 bool cutPathAtPoint(const QPointF &p, const double threshold, const QPainterPath &src, QPainterPath &dest, QPainterPath &rest)
 {
+    QList<QPainterPath> pieces;
+    if(cutPathAtPoints({p}, threshold, src, pieces) == 0)
+        return false;
+
+    dest = pieces.at(0);
+    rest = pieces.at(1);
+    return true;
+}
+
+int cutPathAtPoints(const QList<QPointF> &points, const double threshold, const QPainterPath &src, QList<QPainterPath> &pieces)
+{
+    struct Cut
+    {
+        double factor;
+        QPointF end;
+    };
+
+    QList<bool> usedPoints(points.size(), false);
+    QList<Cut> cuts;
+    int cutCount = 0;
+
+    pieces.clear();
+    pieces.append(QPainterPath());
+
     QPointF lastPoint;
     bool fakeLine = false;
 
-    bool pastCutPoint = false;
-
     const int count = src.elementCount();
     for(int i = 0; i < count; i++)
     {
@@ -24,10 +49,7 @@ bool cutPathAtPoint(const QPointF &p, const double threshold, const QPainterPath
         case QPainterPath::MoveToElement:
         {
             lastPoint = e;
-            if(pastCutPoint)
-                rest.moveTo(lastPoint);
-            else
-                dest.moveTo(lastPoint);
+            pieces.last().moveTo(lastPoint);
             break;
         }
         case QPainterPath::LineToElement:
@@ -42,10 +64,15 @@ bool cutPathAtPoint(const QPointF &p, const double threshold, const QPainterPath
 
             rect.adjust(-adjX, -adjY, adjX, adjY);
 
-            if(!pastCutPoint && rect.contains(p))
+            cuts.clear();
+            for(int j = 0; j < points.size(); j++)
             {
-                //Cut
-                pastCutPoint = true;
+                const QPointF& p = points.at(j);
+                if(usedPoints.at(j) || !rect.contains(p))
+                    continue;
+
+                //Each point cuts only once
+                usedPoints[j] = true;
 
                 //FIXME: we only consider X coord for cut
                 //consider intersection of perpendicular from p to line
@@ -66,18 +93,28 @@ bool cutPathAtPoint(const QPointF &p, const double threshold, const QPainterPath
                     end.setY(line.y1() + line.dy() * factor);
                 }
 
-                //End destination path
-                dest.lineTo(end);
+                cuts.append({factor, end});
+            }
+
+            //Cut in line direction
+            std::sort(cuts.begin(), cuts.end(), [](const Cut& a, const Cut& b) -> bool
+                      {
+                          return a.factor < b.factor;
+                      });
+
+            for(const Cut& cut : std::as_const(cuts))
+            {
+                //End current piece
+                pieces.last().lineTo(cut.end);
 
-                //Start remaining path
-                rest.moveTo(end);
+                //Start next piece
+                pieces.append(QPainterPath());
+                pieces.last().moveTo(cut.end);
+                cutCount++;
             }
 
             lastPoint = e;
-            if(pastCutPoint)
-                rest.lineTo(lastPoint);
-            else
-                dest.lineTo(lastPoint);
+            pieces.last().lineTo(lastPoint);
             break;
         }
         case QPainterPath::CurveToElement:
@@ -94,5 +131,5 @@ bool cutPathAtPoint(const QPointF &p, const double threshold, const QPainterPath
         }
     }
 
-    return pastCutPoint;
+    return cutCount;
 }
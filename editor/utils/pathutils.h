@@ -5,4 +5,8 @@
 
 bool cutPathAtPoint(const QPointF& p, const double threshold, const QPainterPath& src, QPainterPath& dest, QPainterPath& rest);
 
+//Cut path at all points in a single pass, pieces are in path order
+//Points not near any segment are ignored, returns number of cuts
+int cutPathAtPoints(const QList<QPointF>& points, const double threshold, const QPainterPath& src, QList<QPainterPath>& pieces);
+
 #endif // PATHUTILS_H
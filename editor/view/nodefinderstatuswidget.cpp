@@ -22,7 +22,7 @@ NodeFinderStatusWidget::NodeFinderStatusWidget(NodeFinderMgr *mgr, QWidget *pare
 
     splitElemBut = new QToolButton;
     splitElemBut->setText(tr("Split"));
-    splitElemBut->setToolTip(tr("Start element selection and then split selected element at mouse click"));
+    splitElemBut->setToolTip(tr("Start element selection, then place cut points with mouse clicks and split"));
     lay->addWidget(splitElemBut);
 
     addSubElemBut = new QToolButton;
@@ -156,8 +156,8 @@ void NodeFinderStatusWidget::updateMode()
         }
         else if(subMode == EditingSubModes::DoSplitItem)
         {
-            selectElemBut->setText(tr("Select"));
-            selectElemBut->setToolTip(tr("Select element to be split"));
+            selectElemBut->setText(tr("Split"));
+            selectElemBut->setToolTip(tr("Split element at placed cut points"));
         }
         else if(subMode == EditingSubModes::RemovingSubElement)
         {
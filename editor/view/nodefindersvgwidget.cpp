@@ -1,34 +1,114 @@
 #include "nodefindersvgwidget.h"
 #include <ssplib/rendering/ssprenderhelper.h>
+#include <ssplib/utils/tracing.h>
 
 #include "manager/nodefindermgr.h"
 #include "manager/nodefindersvgconverter.h"
+#include "manager/nodefindersuggestionengine.h"
+#include "manager/nodefinderselectionpreview.h"
 
 #include <QSvgRenderer>
 
 #include <QPainter>
+#include <QPaintEvent>
+#include <QScreen>
 
 #include <QMouseEvent>
 
+//Used if screen refresh rate is not available
+static constexpr qreal DefaultRefreshRate = 60;
+
 NodeFinderSVGWidget::NodeFinderSVGWidget(ssplib::StationPlan *plan, NodeFinderMgr *mgr, QWidget *parent) :
     ssplib::SSPViewer(plan, parent),
-    nodeMgr(mgr)
+    nodeMgr(mgr),
+    m_contentValid(false)
 {
     setBackgroundRole(QPalette::Light);
     setPlan(plan);
+
+    //Cached content covers whole widget
+    setAttribute(Qt::WA_OpaquePaintEvent);
+
+    m_overlayTimer.setSingleShot(true);
+    connect(&m_overlayTimer, &QTimer::timeout, this, &NodeFinderSVGWidget::flushOverlay);
+
+    connect(nodeMgr, &NodeFinderMgr::selectionMoved, this, &NodeFinderSVGWidget::onSelectionMoved);
+}
+
+void NodeFinderSVGWidget::invalidateContent()
+{
+    m_contentValid = false;
+    update();
+}
+
+void NodeFinderSVGWidget::onSelectionMoved(const QRectF &oldRect, const QRectF &newRect)
+{
+    m_dirtyOverlay += overlayRect(oldRect);
+    m_dirtyOverlay += overlayRect(newRect);
+
+    //Coalesce mouse moves to one repaint per screen refresh
+    if(!m_overlayTimer.isActive())
+    {
+        qreal refreshRate = screen() ? screen()->refreshRate() : DefaultRefreshRate;
+        if(refreshRate <= 0)
+            refreshRate = DefaultRefreshRate;
+        m_overlayTimer.start(qMax(1, qRound(1000.0 / refreshRate)));
+    }
+}
+
+void NodeFinderSVGWidget::flushOverlay()
+{
+    update(m_dirtyOverlay);
+    m_dirtyOverlay = QRegion();
+}
+
+void NodeFinderSVGWidget::paintEvent(QPaintEvent *e)
+{
+    const qreal dpr = devicePixelRatioF();
+
+    //Render SVG and items only when they change or are scrolled in view
+    //Rubber band updates reuse cached content
+    if(!m_contentValid || !m_contentRect.contains(e->rect()) || m_content.devicePixelRatio() != dpr)
+    {
+        m_contentRect = visibleRegion().boundingRect().united(e->rect());
+
+        m_content = QPixmap(m_contentRect.size() * dpr);
+        m_content.setDevicePixelRatio(dpr);
+        m_content.fill(palette().color(backgroundRole()));
+
+        QPainter contentPainter(&m_content);
+        paintContent(&contentPainter, QRectF(rect()).translated(-m_contentRect.topLeft()));
+        m_contentValid = true;
+    }
+
+    QPainter p(this);
+
+    //Source rect is in pixmap device pixels
+    const QRectF dirty = e->rect();
+    const QRectF source(dirty.topLeft() - m_contentRect.topLeft(), dirty.size());
+    p.drawPixmap(dirty, m_content, QRectF(source.topLeft() * dpr, source.size() * dpr));
+
+    paintSelection(&p);
 }
 
-void NodeFinderSVGWidget::paintEvent(QPaintEvent *)
+void NodeFinderSVGWidget::resizeEvent(QResizeEvent *e)
 {
+    m_contentValid = false;
+    ssplib::SSPViewer::resizeEvent(e);
+}
+
+void NodeFinderSVGWidget::paintContent(QPainter *painter, const QRectF& target)
+{
+    SSPLIB_TRACE_SCOPE_CAT("NodeFinderSVGWidget::paintContent", "editor");
+
     static constexpr double PenWidthFactor = 1.5;
 
-    const QRectF target = rect();
-    const QRectF source = mSvg ? mSvg->viewBoxF() : target;
+    const QRectF source = mSvg ? mSvg->viewBoxF() : QRectF(rect());
 
     QPen trackPen(Qt::darkGreen, nodeMgr->getTrackPenWidth());
     trackPen.setCapStyle(Qt::RoundCap);
 
-    QPainter p(this);
+    QPainter &p = *painter;
 
     //Draw SVG image
     if(mSvg)
@@ -88,10 +168,108 @@ void NodeFinderSVGWidget::paintEvent(QPaintEvent *)
         }
     }
 
+    //Draw pending cut points
+    const QList<QPointF>& splitPoints = nodeMgr->getSplitPoints();
+    if(!splitPoints.isEmpty())
+    {
+        const double radius = nodeMgr->getTrackPenWidth() / 2.0;
+        p.setPen(Qt::NoPen);
+        p.setBrush(Qt::red);
+        for(const QPointF& pt : splitPoints)
+            p.drawEllipse(pt, radius, radius);
+    }
+
+    //Draw tag suggestions
+    const QList<NodeFinderSuggestion>& suggestions = nodeMgr->getSuggestions();
+    if(!suggestions.isEmpty())
+    {
+        const int curSuggestion = nodeMgr->currentSuggestion();
+
+        QPen suggestionPen = trackPen;
+        p.setBrush(Qt::NoBrush);
+
+        for(int i = 0; i < suggestions.size(); i++)
+        {
+            if(i == curSuggestion)
+                continue; //Drawn on top later
+
+            const NodeFinderSuggestion& s = suggestions.at(i);
+            QColor color(s.type == NodeFinderSuggestion::Type::TrackPos ? Qt::cyan : Qt::magenta);
+            color.setAlpha(160);
+            suggestionPen.setColor(color);
+            p.setPen(suggestionPen);
+
+            for(const ssplib::ElementPath& elem : s.elements)
+                p.drawPath(elem.path);
+        }
+
+        if(curSuggestion >= 0 && curSuggestion < suggestions.size())
+        {
+            //Highlight current suggestion and describe it
+            const NodeFinderSuggestion& s = suggestions.at(curSuggestion);
+            suggestionPen.setColor(Qt::yellow);
+            suggestionPen.setWidthF(trackPen.widthF() * PenWidthFactor);
+            p.setPen(suggestionPen);
+
+            for(const ssplib::ElementPath& elem : s.elements)
+                p.drawPath(elem.path);
+
+            p.setPen(Qt::black);
+            p.drawText(s.bounds.center(), s.description);
+        }
+    }
+}
+
+void NodeFinderSVGWidget::paintSelection(QPainter *painter)
+{
+    const QRectF selection = nodeMgr->getSelectionRect();
+    if(selection.isNull())
+        return;
+
+    const QRectF target = rect();
+    const QRectF source = mSvg ? mSvg->viewBoxF() : target;
+    painter->setTransform(ssplib::SSPRenderHelper::getTranform(target, source));
+
     //Draw selection rect
     QColor col(nodeMgr->isSelecting() ? Qt::red : Qt::green);
     col.setAlpha(50);
-    p.fillRect(nodeMgr->getSelectionRect(), col);
+    painter->fillRect(selection, col);
+
+    const NodeFinderSelectionPreview *preview = nodeMgr->getSelectionPreview();
+    if(!preview->isActive())
+        return;
+
+    //Outline captured elements, cosmetic pen keeps them thin at any zoom
+    QPen outlinePen(QColor(255, 140, 0), 0);
+    painter->setPen(outlinePen);
+    painter->setBrush(Qt::NoBrush);
+    for(const NodeFinderSelectionPreview::Captured& item : preview->captured())
+        painter->drawPath(item.path);
+
+    //Draw count in widget coordinates so text is not scaled
+    const QRect viewRect = painter->transform().mapRect(selection).toAlignedRect();
+    painter->resetTransform();
+    painter->setPen(Qt::black);
+    painter->drawText(viewRect.topLeft() + QPoint(OverlayTextMargin, OverlayTextMargin + fontMetrics().ascent()),
+                      tr("%n element(s)", nullptr, preview->count()));
+}
+
+QRect NodeFinderSVGWidget::overlayRect(const QRectF &sceneRect) const
+{
+    if(sceneRect.isNull())
+        return QRect();
+
+    const QRectF target = rect();
+    const QRectF source = mSvg ? mSvg->viewBoxF() : target;
+    const QRect viewRect = ssplib::SSPRenderHelper::getTranform(target, source).mapRect(sceneRect).toAlignedRect();
+
+    //Count text may be wider than a small rect
+    const QSize textSize(fontMetrics().horizontalAdvance(tr("%n element(s)", nullptr, 9999999)),
+                         fontMetrics().height());
+    const QRect textRect(viewRect.topLeft(), textSize + QSize(OverlayTextMargin, OverlayTextMargin) * 2);
+
+    //Grow for antialiasing and outline pen
+    return viewRect.united(textRect).adjusted(-2, -2, 2, 2);
 }
 
 void NodeFinderSVGWidget::mousePressEvent(QMouseEvent *e)
@@ -155,7 +333,20 @@ void NodeFinderSVGWidget::keyPressEvent(QKeyEvent *e)
     case Qt::Key_Return:
     case Qt::Key_Enter:
     {
-        nodeMgr->selectCurrentElem();
+        if(nodeMgr->currentSuggestion() >= 0)
+            nodeMgr->acceptCurrentSuggestion();
+        else
+            nodeMgr->selectCurrentElem();
+        break;
+    }
+    case Qt::Key_Delete:
+    {
+        if(nodeMgr->currentSuggestion() < 0)
+        {
+            e->ignore();
+            return;
+        }
+        nodeMgr->rejectCurrentSuggestion();
         break;
     }
     case Qt::Key_D:
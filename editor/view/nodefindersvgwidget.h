@@ -3,6 +3,10 @@
 
 #include <ssplib/rendering/sspviewer.h>
 
+#include <QPixmap>
+#include <QRegion>
+#include <QTimer>
+
 class NodeFinderMgr;
 
 class NodeFinderSVGWidget : public ssplib::SSPViewer
@@ -11,8 +15,17 @@ class NodeFinderSVGWidget : public ssplib::SSPViewer
 public:
     explicit NodeFinderSVGWidget(ssplib::StationPlan *plan, NodeFinderMgr *mgr, QWidget *parent = nullptr);
 
+public slots:
+    //Call when SVG or items change, rubber band is handled separately
+    void invalidateContent();
+
+private slots:
+    void onSelectionMoved(const QRectF& oldRect, const QRectF& newRect);
+    void flushOverlay();
+
 protected:
-    void paintEvent(QPaintEvent *) override;
+    void paintEvent(QPaintEvent *e) override;
+    void resizeEvent(QResizeEvent *e) override;
 
     void mousePressEvent(QMouseEvent *e) override;
     void mouseMoveEvent(QMouseEvent *e) override;
@@ -20,8 +33,26 @@ protected:
 
     void keyPressEvent(QKeyEvent *e) override;
 
+private:
+    void paintContent(QPainter *painter, const QRectF &target);
+    void paintSelection(QPainter *painter);
+
+    //Area of view covered by selection overlay
+    QRect overlayRect(const QRectF& sceneRect) const;
+
+    static constexpr int OverlayTextMargin = 4;
+
 private:
     NodeFinderMgr *nodeMgr;
+
+    //SVG and items rendered for visible area
+    QPixmap m_content;
+    QRect m_contentRect;
+    bool m_contentValid;
+
+    //Rubber band areas to repaint on next screen refresh
+    QRegion m_dirtyOverlay;
+    QTimer m_overlayTimer;
 };
 
 #endif // NODEFINDERSVGWIDGET_H
@@ -0,0 +1,28 @@
+#include "fuzzhelpers.h"
+
+#include <QPainterPath>
+
+#include <ssplib/utils/svg_constants.h>
+#include <ssplib/utils/svg_path_utils.h>
+#include <ssplib/utils/xmlelement.h>
+
+using namespace ssplib;
+
+//Input is used as path "d" and polyline "points" attribute
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    const QString input = fuzzInputToString(data, size);
+    FuzzTimeBudget budget(size);
+
+    QXmlStreamAttributes pathAttrs;
+    pathAttrs.append(QLatin1String("d"), input);
+    QPainterPath path;
+    utils::convertElementToPath(utils::XmlElement(svg_tags::PathTag, pathAttrs), path);
+
+    QXmlStreamAttributes polylineAttrs;
+    polylineAttrs.append(QLatin1String("points"), input);
+    QPainterPath polyline;
+    utils::convertElementToPath(utils::XmlElement(svg_tags::PolylineTag, polylineAttrs), polyline);
+
+    return 0;
+}
@@ -0,0 +1,24 @@
+#include "fuzzhelpers.h"
+
+#include <ssplib/utils/svg_path_utils.h>
+
+using namespace ssplib;
+
+//Number and point lists as found in polyline points and transforms
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    const QString input = fuzzInputToString(data, size);
+    FuzzTimeBudget budget(size);
+
+    QStringView str(input);
+    double val = 0;
+    while(!str.isEmpty() && utils::parseNumberAndAdvance(val, str))
+        ;
+
+    str = QStringView(input);
+    QPointF pt;
+    while(!str.isEmpty() && utils::parsePointAndAdvance(pt, str))
+        ;
+
+    return 0;
+}
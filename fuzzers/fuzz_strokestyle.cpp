@@ -0,0 +1,27 @@
+#include "fuzzhelpers.h"
+
+#include <ssplib/utils/svg_constants.h>
+#include <ssplib/utils/svg_path_utils.h>
+#include <ssplib/utils/xmlelement.h>
+
+using namespace ssplib;
+
+//Input is used as CSS "style" and as "stroke-width" attribute
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    const QString input = fuzzInputToString(data, size);
+    FuzzTimeBudget budget(size);
+
+    const utils::ElementStyle parentStyle;
+    const QRectF bounds(0, 0, 100, 50);
+
+    QXmlStreamAttributes styleAttrs;
+    styleAttrs.append(QLatin1String("style"), input);
+    utils::parseStrokeWidthStyle(utils::XmlElement(svg_tags::PathTag, styleAttrs), parentStyle, bounds);
+
+    QXmlStreamAttributes widthAttrs;
+    widthAttrs.append(QLatin1String("stroke-width"), input);
+    utils::parseStrokeWidthStyle(utils::XmlElement(svg_tags::PathTag, widthAttrs), parentStyle, bounds);
+
+    return 0;
+}
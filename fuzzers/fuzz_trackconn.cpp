@@ -0,0 +1,43 @@
+#include "fuzzhelpers.h"
+
+#include <ssplib/itemtypes.h>
+#include <ssplib/utils/svg_path_utils.h>
+
+using namespace ssplib;
+
+//Parsed connections must survive a round trip through trackConnInfoToString()
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    const QString input = fuzzInputToString(data, size);
+    FuzzTimeBudget budget(size);
+
+    QList<TrackConnectionInfo> vec;
+    utils::parseTrackConnectionAttribute(input, vec);
+
+    const QString value = utils::trackConnInfoToString(vec);
+
+    QList<TrackConnectionInfo> roundTrip;
+    utils::parseTrackConnectionAttribute(value, roundTrip);
+
+    if(roundTrip.size() != vec.size())
+    {
+        fprintf(stderr, "==SSP FUZZ== round trip lost connections: %lld -> %lld\n",
+                qint64(vec.size()), qint64(roundTrip.size()));
+        abort();
+    }
+
+    for(int i = 0; i < vec.size(); i++)
+    {
+        const TrackConnectionInfo& a = vec.at(i);
+        const TrackConnectionInfo& b = roundTrip.at(i);
+        if(a.gateLetter != b.gateLetter || a.gateTrackPos != b.gateTrackPos
+            || a.stationTrackPos != b.stationTrackPos || a.trackSide != b.trackSide)
+        {
+            fprintf(stderr, "==SSP FUZZ== round trip mismatch at %d: \"%s\"\n",
+                    i, qPrintable(value));
+            abort();
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,23 @@
+#include "fuzzhelpers.h"
+
+#include <QStringList>
+
+#include <ssplib/utils/transform_utils.h>
+
+using namespace ssplib;
+
+//Input lines are nested transforms, like group chains combined by parsers
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    const QString input = fuzzInputToString(data, size);
+    FuzzTimeBudget budget(size);
+
+    utils::parseTransformationMatrix(input);
+
+    utils::Transform t;
+    const QStringList lines = input.split('\n');
+    for(const QString& line : lines)
+        t = utils::combineTransform(t, line);
+
+    return 0;
+}
@@ -0,0 +1,60 @@
+#ifndef SSP_FUZZHELPERS_H
+#define SSP_FUZZHELPERS_H
+
+#include <QElapsedTimer>
+#include <QString>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+//Attribute values are always QString in real callers
+inline QString fuzzInputToString(const uint8_t *data, size_t size)
+{
+    return QString::fromUtf8(reinterpret_cast<const char *>(data), qsizetype(size));
+}
+
+inline qint64 fuzzEnvValue(const char *name, qint64 defaultVal)
+{
+    bool ok = false;
+    const qint64 val = qEnvironmentVariable(name).toLongLong(&ok);
+    return ok && val > 0 ? val : defaultVal;
+}
+
+//Aborts when one input takes longer than a budget proportional to its size
+//Parsers are expected to be linear so quadratic inputs quickly exceed it,
+//while libFuzzer -timeout only catches real hangs.
+//Budget can be tuned with SSP_FUZZ_BASE_NS and SSP_FUZZ_NS_PER_BYTE
+class FuzzTimeBudget
+{
+public:
+    inline explicit FuzzTimeBudget(size_t size) :
+        m_size(size)
+    {
+        m_timer.start();
+    }
+
+    inline ~FuzzTimeBudget()
+    {
+        static const qint64 baseNs = fuzzEnvValue("SSP_FUZZ_BASE_NS", 50000000);
+        static const qint64 nsPerByte = fuzzEnvValue("SSP_FUZZ_NS_PER_BYTE", 5000);
+
+        const qint64 elapsed = m_timer.nsecsElapsed();
+        const qint64 budget = baseNs + nsPerByte * qint64(m_size);
+        if(elapsed > budget)
+        {
+            fprintf(stderr, "==SSP FUZZ== super-linear input: %lld ns for %zu bytes (budget %lld ns)\n",
+                    elapsed, m_size, budget);
+            abort();
+        }
+    }
+
+    FuzzTimeBudget(const FuzzTimeBudget&) = delete;
+    FuzzTimeBudget& operator=(const FuzzTimeBudget&) = delete;
+
+private:
+    QElapsedTimer m_timer;
+    size_t m_size;
+};
+
+#endif // SSP_FUZZHELPERS_H
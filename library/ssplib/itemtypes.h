@@ -3,6 +3,7 @@
 
 #include <QString>
 #include <QPainterPath>
+#include <QSharedPointer>
 #include <QRgb>
 
 #ifdef SSPLIB_ENABLE_EDITING
@@ -24,6 +25,8 @@ enum class Side : qint8
     NSides
 };
 
+struct LazyElementGeometry;
+
 struct ElementPath
 {
 #ifdef SSPLIB_ENABLE_EDITING
@@ -31,6 +34,20 @@ struct ElementPath
 #endif
     QPainterPath path;
     double strokeWidth = 0;
+
+    //Set only when parsed with lazy geometry, path is converted on first access
+    //Use getPath() and getStrokeWidth() when plan may be lazy
+    QSharedPointer<LazyElementGeometry> lazy;
+
+    const QPainterPath& getPath() const;
+    double getStrokeWidth() const;
+};
+
+//Per view item state, see StationPlanState
+struct ItemState
+{
+    QRgb color = whiteRGB;
+    bool visible = false;
 };
 
 struct ItemBase
@@ -90,6 +107,17 @@ struct TrackConnectionInfo
                && gateTrackPos == other.gateTrackPos && trackSide == other.trackSide;
     }
 
+    //Hash key of fields compared by matchNames()
+    //NOTE: track positions are truncated to 16 bits so equal keys
+    //must still be confirmed with matchNames()
+    inline quint64 namesKey() const
+    {
+        return (quint64(quint16(stationTrackPos)) << 48)
+               | (quint64(quint16(gateTrackPos)) << 32)
+               | (quint64(gateLetter.unicode()) << 16)
+               | quint64(quint8(trackSide));
+    }
+
     template <typename Container>
     static inline void removeAllNames(Container &vec, const TrackConnectionInfo& info)
     {
@@ -8,6 +8,7 @@
 
 #include "parsinghelpers.h"
 #include <ssplib/utils/transform_utils.h>
+#include <ssplib/utils/tracing.h>
 
 #include <QDebug>
 
@@ -15,6 +16,22 @@
 
 using namespace ssplib;
 
+//Elements processed between progress reports
+static constexpr int ProgressInterval = 64;
+
+//Counts elements visited by processGroup()
+static int countGroupElements(const QDomElement& g)
+{
+    int count = 0;
+    for(QDomElement e = g.firstChildElement(); !e.isNull(); e = e.nextSiblingElement())
+    {
+        count++;
+        if(e.tagName() == ssplib::svg_tags::GroupTag)
+            count += countGroupElements(e);
+    }
+    return count;
+}
+
 void applyTransform(utils::Transform& transf, QDomElement& e)
 {
     QString val = transf.value;
@@ -32,16 +49,33 @@ void applyTransform(utils::Transform& transf, QDomElement& e)
 DOMParser::DOMParser(QDomDocument *doc, StationPlan *ptr, EditingInfo *info) :
     m_doc(doc),
     plan(ptr),
-    m_info(info)
+    m_info(info),
+    m_processedCount(0),
+    m_totalCount(0),
+    m_stopped(false)
 {
 
 }
 
 bool DOMParser::parse()
 {
+    SSPLIB_TRACE_SCOPE("DOMParser::parse");
+
     QDomElement root = m_doc->documentElement();
+
+    m_processedCount = 0;
+    m_totalCount = progressCallback ? countGroupElements(root) : 0;
+    m_stopped = false;
+
+    //Generated ids must not collide with explicit ids found later in document
+    m_info->reserveDocumentIds(root);
+
     processGroup(root, utils::ElementStyle(), utils::Transform());
-    return true;
+
+    if(!m_stopped && progressCallback)
+        progressCallback(m_totalCount, m_totalCount);
+
+    return !m_stopped;
 }
 
 void DOMParser::processGroup(QDomElement &g, const utils::ElementStyle& parentStyle, const utils::Transform &parentTransf)
@@ -56,7 +90,7 @@ void DOMParser::processGroup(QDomElement &g, const utils::ElementStyle& parentSt
     }
 
     QDomNode n = g.firstChild();
-    while(!n.isNull())
+    while(!n.isNull() && !m_stopped)
     {
         // Try to convert the node to an element.
         QDomElement e = n.toElement();
@@ -65,6 +99,9 @@ void DOMParser::processGroup(QDomElement &g, const utils::ElementStyle& parentSt
             // The node really is an element.
             m_info->storeElement(e);
 
+            if(!reportProgress())
+                return;
+
             bool tranformProcessed = false;
 
             if(e.tagName() == ssplib::svg_tags::GroupTag)
@@ -141,6 +178,17 @@ void DOMParser::processGroup(QDomElement &g, const utils::ElementStyle& parentSt
     }
 }
 
+bool DOMParser::reportProgress()
+{
+    m_processedCount++;
+    if(!progressCallback || m_processedCount % ProgressInterval != 0)
+        return true;
+
+    if(!progressCallback(m_processedCount, m_totalCount))
+        m_stopped = true;
+    return !m_stopped;
+}
+
 void DOMParser::processDefs(QDomElement &defs)
 {
     QDomNode n = defs.firstChild();
@@ -158,12 +206,8 @@ void DOMParser::processDefs(QDomElement &defs)
                 //Add ID if missing
                 if(!e.hasAttribute(ssplib::svg_attr::ID))
                 {
-                    int counter = 0;
-                    const QString newId = m_info->getFreeId_internal(QLatin1String("font_"), counter);
-                    if(newId.isEmpty())
-                        qWarning() << "EMPTY FONT ID";
-                    else
-                        e.setAttribute(ssplib::svg_attr::ID, newId);
+                    const QString newId = m_info->generateId(QLatin1String("font_"));
+                    e.setAttribute(ssplib::svg_attr::ID, newId);
                 }
             }
         }
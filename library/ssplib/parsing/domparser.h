@@ -3,6 +3,8 @@
 
 #ifdef SSPLIB_ENABLE_EDITING
 
+#include <functional>
+
 class QDomDocument;
 class QDomElement;
 class QString;
@@ -22,8 +24,14 @@ class DOMParser
 public:
     DOMParser(QDomDocument *doc, StationPlan *ptr, EditingInfo *info);
 
+    //Returns false if stopped by progress callback
     bool parse();
 
+    //Called periodically with processed and total element count
+    //Return false to stop parsing, document is then left partially processed
+    typedef std::function<bool(int, int)> ProgressCallback;
+    inline void setProgressCallback(const ProgressCallback& func) { progressCallback = func; }
+
 private:
     void processGroup(QDomElement& g,
                       const ssplib::utils::ElementStyle &parentStyle,
@@ -32,10 +40,17 @@ private:
     void processText(QDomElement& text, utils::Transform &parentTransf);
     void processInternalTspan(QDomElement &top, QDomElement &cur, QString &value);
 
+    bool reportProgress();
+
 private:
     QDomDocument *m_doc;
     StationPlan *plan;
     EditingInfo *m_info;
+
+    ProgressCallback progressCallback;
+    int m_processedCount;
+    int m_totalCount;
+    bool m_stopped;
 };
 
 } // namespace ssplib
@@ -7,7 +7,6 @@
 using namespace ssplib;
 
 EditingInfo::EditingInfo() :
-    generatedIdSerial(0),
     generatedIdBase(QLatin1String("generated_"))
 {
 
@@ -21,11 +20,12 @@ void EditingInfo::storeElement(QDomElement &e)
         if(namedElements.contains(id))
         {
             //Duplicate id, rename element
-            id = getFreeId_internal(generatedIdBase, generatedIdSerial);
-            if(id.isEmpty())
-                e.removeAttribute(ssplib::svg_attr::ID);
-            else
-                e.setAttribute(ssplib::svg_attr::ID, id);
+            id = generateId(generatedIdBase);
+            e.setAttribute(ssplib::svg_attr::ID, id);
+        }
+        else
+        {
+            reserveId(id);
         }
         namedElements.insert(id, e);
     }
@@ -40,23 +40,50 @@ void EditingInfo::clear()
     resetIdGenerator();
 
     namedElements.clear();
+    usedIds.clear();
+    usedIds.squeeze();
 }
 
 void EditingInfo::resetIdGenerator()
 {
-    generatedIdSerial = 0;
+    idCounters.clear();
+}
+
+void EditingInfo::reserveDocumentIds(const QDomElement &root)
+{
+    //Iterative pre-order walk, documents can be deeply nested
+    QDomElement e = root;
+    while(!e.isNull())
+    {
+        const QString id = e.attribute(ssplib::svg_attr::ID);
+        if(!id.isEmpty())
+            reserveId(id);
+
+        QDomElement next = e.firstChildElement();
+        while(next.isNull() && !e.isNull() && e != root)
+        {
+            next = e.nextSiblingElement();
+            if(next.isNull())
+                e = e.parentNode().toElement();
+        }
+        e = next;
+    }
 }
 
-QString EditingInfo::getFreeId_internal(const QString &base, int &counter)
+QString EditingInfo::generateId(const QString &base)
 {
-    const QString fmt = base + QLatin1String("%1");
-    for(int i = 0; i < 2000; i++)
+    //Counters only grow so each serial is tried at most once per base
+    int &counter = idCounters[base];
+
+    QString id;
+    do
     {
-        const QString id = fmt.arg(counter++);
-        if(!namedElements.contains(id))
-            return id;
+        id = base + QString::number(counter++);
     }
-    return QString();
+    while(usedIds.contains(id));
+
+    usedIds.insert(id);
+    return id;
 }
 
 #endif // SSPLIB_ENABLE_EDITING
@@ -7,6 +7,8 @@
 #include <QDomElement>
 
 #include <QMap>
+#include <QHash>
+#include <QSet>
 
 namespace ssplib {
 
@@ -22,7 +24,18 @@ public:
     void clear();
 
     void resetIdGenerator();
-    QString getFreeId_internal(const QString &base, int &counter);
+
+    //Returns an unused id made of base and a serial number, never fails
+    //Generated ids are reserved until clear() so they are not reused
+    //even if element is renamed (undo might restore them)
+    QString generateId(const QString &base);
+
+    //Mark an id as used so it will not be generated
+    inline void reserveId(const QString &id) { usedIds.insert(id); }
+
+    //Mark ids of all elements under root as used
+    //Call before storing elements so generated ids never take an explicit one
+    void reserveDocumentIds(const QDomElement &root);
 
     typedef std::function<void(QDomElement &)> Callback;
     inline void setCallback(const Callback& func) { callback = func; }
@@ -31,8 +44,9 @@ public:
     ElementMap namedElements;
 
 private:
-    int generatedIdSerial;
     QString generatedIdBase;
+    QHash<QString, int> idCounters; //Next serial for each base
+    QSet<QString> usedIds;
     Callback callback;
 };
 
@@ -0,0 +1,76 @@
+#include "lazygeometry.h"
+
+#include <ssplib/utils/memoryusage.h>
+
+using namespace ssplib;
+
+//Attributes needed to convert supported elements and parse stroke width
+static const QString geometryAttrs[] =
+    {QLatin1String("d"),
+     QLatin1String("points"),
+     QLatin1String("x"), QLatin1String("y"),
+     QLatin1String("x1"), QLatin1String("y1"),
+     QLatin1String("x2"), QLatin1String("y2"),
+     QLatin1String("width"), QLatin1String("height"),
+     QLatin1String("style"), QLatin1String("stroke-width")};
+
+void LazyElementGeometry::materialize()
+{
+    if(materialized)
+        return;
+    materialized = true;
+
+    if(!utils::convertElementToPath(raw, path))
+        path = QPainterPath();
+
+    strokeWidth = 0;
+    if(!utils::parseStrokeWidth(raw, parentStyle, path.boundingRect(), strokeWidth))
+        strokeWidth = 0;
+
+    //Raw attributes are not needed anymore
+    raw = utils::XmlElement();
+    rawBytes = 0;
+}
+
+QSharedPointer<LazyElementGeometry> LazyElementGeometry::create(const utils::XmlElement &e,
+                                                                const utils::ElementStyle &parentStyle)
+{
+    //Copy only geometry attributes, do not keep references to parser buffers
+    QXmlStreamAttributes attrs;
+    qint64 rawBytes = 0;
+    for(const QString& name : geometryAttrs)
+    {
+        if(e.hasAttribute(name))
+        {
+            const QString value = e.attribute(name);
+            attrs.append(name, value);
+            rawBytes += utils::stringBytes(name) + utils::stringBytes(value);
+        }
+    }
+
+    QSharedPointer<LazyElementGeometry> geom(new LazyElementGeometry);
+    geom->rawBytes = rawBytes;
+    geom->raw = utils::XmlElement(e.tagName(), attrs);
+    geom->parentStyle = parentStyle;
+    return geom;
+}
+
+const QPainterPath &ElementPath::getPath() const
+{
+    if(lazy)
+    {
+        lazy->materialize();
+        return lazy->path;
+    }
+    return path;
+}
+
+double ElementPath::getStrokeWidth() const
+{
+    if(lazy)
+    {
+        lazy->materialize();
+        return lazy->strokeWidth;
+    }
+    return strokeWidth;
+}
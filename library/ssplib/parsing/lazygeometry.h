@@ -0,0 +1,29 @@
+#ifndef SSPLIB_LAZYGEOMETRY_H
+#define SSPLIB_LAZYGEOMETRY_H
+
+#include <ssplib/utils/svg_path_utils.h>
+#include <ssplib/utils/xmlelement.h>
+
+namespace ssplib {
+
+//Raw element attributes kept until geometry is needed for drawing or hit testing
+//Shared between all copies of the same ElementPath so conversion happens once
+struct LazyElementGeometry
+{
+    utils::XmlElement raw;
+    utils::ElementStyle parentStyle;
+
+    QPainterPath path;
+    double strokeWidth = 0;
+    qint64 rawBytes = 0; //Size of raw attributes, for memory accounting
+    bool materialized = false;
+
+    void materialize();
+
+    static QSharedPointer<LazyElementGeometry> create(const utils::XmlElement &e,
+                                                      const utils::ElementStyle &parentStyle);
+};
+
+} // namespace ssplib
+
+#endif // SSPLIB_LAZYGEOMETRY_H
@@ -1,5 +1,7 @@
 #include "parsinghelpers.h"
 
+#include "lazygeometry.h"
+
 #include <QString>
 
 namespace ssplib {
@@ -30,10 +32,35 @@ bool parsing::isElementSupported(const QString &tag)
     return false;
 }
 
+static bool buildElementPath(utils::XmlElement &e, const utils::ElementStyle &parentStyle,
+                             bool lazyGeometry, ElementPath &elemPath)
+{
+#ifdef SSPLIB_ENABLE_EDITING
+    elemPath.elem = e.toElement();
+#endif
+
+    if(lazyGeometry)
+    {
+        //Path and stroke width will be calculated on first access
+        elemPath.lazy = LazyElementGeometry::create(e, parentStyle);
+        return true;
+    }
+
+    if(!utils::convertElementToPath(e, elemPath.path))
+        return false;
+
+    elemPath.strokeWidth = 0;
+    if(!utils::parseStrokeWidth(e, parentStyle, elemPath.path.boundingRect(), elemPath.strokeWidth))
+        elemPath.strokeWidth = 0;
+
+    return true;
+}
+
 } // namespace ssplib
 
 
-bool ssplib::parsing::parseLabel(utils::XmlElement &e, QList<LabelItem> &labels, const utils::ElementStyle &parentStyle)
+bool ssplib::parsing::parseLabel(utils::XmlElement &e, QList<LabelItem> &labels, const utils::ElementStyle &parentStyle,
+                                 bool lazyGeometry)
 {
     QString labelName = e.attribute(svg_attr::LabelName);
     if(labelName.isEmpty())
@@ -49,13 +76,9 @@ bool ssplib::parsing::parseLabel(utils::XmlElement &e, QList<LabelItem> &labels,
 
     ElementPath elemPath;
 
-#ifdef SSPLIB_ENABLE_EDITING
-    elemPath.elem = e.toElement();
-#endif
-
     if(ok)
     {
-        ok = utils::convertElementToPath(e, elemPath.path);
+        ok = buildElementPath(e, parentStyle, lazyGeometry, elemPath);
     }
 
     if(!ok)
@@ -83,10 +106,6 @@ bool ssplib::parsing::parseLabel(utils::XmlElement &e, QList<LabelItem> &labels,
         i = labels.size() - 1;
     }
 
-    elemPath.strokeWidth = 0;
-    if(!utils::parseStrokeWidth(e, parentStyle, elemPath.path.boundingRect(), elemPath.strokeWidth))
-        elemPath.strokeWidth = 0;
-
     //Add element to label
     LabelItem &item = labels[i];
     item.elements.append(elemPath);
@@ -94,7 +113,8 @@ bool ssplib::parsing::parseLabel(utils::XmlElement &e, QList<LabelItem> &labels,
     return true;
 }
 
-bool ssplib::parsing::parsePlatform(utils::XmlElement &e, QList<TrackItem> &platforms, const utils::ElementStyle& parentStyle)
+bool ssplib::parsing::parsePlatform(utils::XmlElement &e, QList<TrackItem> &platforms, const utils::ElementStyle& parentStyle,
+                                    bool lazyGeometry)
 {
     QString trackPosStr = e.attribute(svg_attr::TrackPos);
     if(trackPosStr.isEmpty())
@@ -105,13 +125,9 @@ bool ssplib::parsing::parsePlatform(utils::XmlElement &e, QList<TrackItem> &plat
 
     ElementPath elemPath;
 
-#ifdef SSPLIB_ENABLE_EDITING
-    elemPath.elem = e.toElement();
-#endif
-
     if(ok)
     {
-        ok = utils::convertElementToPath(e, elemPath.path);
+        ok = buildElementPath(e, parentStyle, lazyGeometry, elemPath);
     }
 
     if(!ok)
@@ -138,10 +154,6 @@ bool ssplib::parsing::parsePlatform(utils::XmlElement &e, QList<TrackItem> &plat
         i = platforms.size() - 1;
     }
 
-    elemPath.strokeWidth = 0;
-    if(!utils::parseStrokeWidth(e, parentStyle, elemPath.path.boundingRect(), elemPath.strokeWidth))
-        elemPath.strokeWidth = 0;
-
     //Add element to platform
     TrackItem &item = platforms[i];
     item.elements.append(elemPath);
@@ -151,7 +163,8 @@ bool ssplib::parsing::parsePlatform(utils::XmlElement &e, QList<TrackItem> &plat
 
 bool ssplib::parsing::parseTrackConnection(utils::XmlElement &e,
                                            QList<TrackConnectionItem> &connections,
-                                           const utils::ElementStyle &parentStyle)
+                                           const utils::ElementStyle &parentStyle,
+                                           bool lazyGeometry)
 {
     QString trackConnStr = e.attribute(svg_attr::TrackConnections);
     if(trackConnStr.isEmpty())
@@ -162,13 +175,9 @@ bool ssplib::parsing::parseTrackConnection(utils::XmlElement &e,
 
     ElementPath elemPath;
 
-#ifdef SSPLIB_ENABLE_EDITING
-    elemPath.elem = e.toElement();
-#endif
-
     if(ok)
     {
-        ok = utils::convertElementToPath(e, elemPath.path);
+        ok = buildElementPath(e, parentStyle, lazyGeometry, elemPath);
     }
 
     if(!ok)
@@ -178,10 +187,6 @@ bool ssplib::parsing::parseTrackConnection(utils::XmlElement &e,
         return false;
     }
 
-    elemPath.strokeWidth = 0;
-    if(!utils::parseStrokeWidth(e, parentStyle, elemPath.path.boundingRect(), elemPath.strokeWidth))
-        elemPath.strokeWidth = 0;
-
     for(const TrackConnectionInfo& info : std::as_const(infoVec))
     {
         //Find track connection
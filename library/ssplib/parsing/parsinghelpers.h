@@ -9,13 +9,17 @@ namespace ssplib {
 
 namespace parsing {
 
-bool parseLabel(utils::XmlElement &e, QList<LabelItem> &labels, const utils::ElementStyle &parentStyle);
+//With lazyGeometry only raw attributes are stored, see LazyElementGeometry
+bool parseLabel(utils::XmlElement &e, QList<LabelItem> &labels, const utils::ElementStyle &parentStyle,
+                bool lazyGeometry = false);
 
-bool parsePlatform(utils::XmlElement &e, QList<TrackItem> &platforms, const utils::ElementStyle &parentStyle);
+bool parsePlatform(utils::XmlElement &e, QList<TrackItem> &platforms, const utils::ElementStyle &parentStyle,
+                   bool lazyGeometry = false);
 
 bool parseTrackConnection(utils::XmlElement &e,
                           QList<TrackConnectionItem> &connections,
-                          const utils::ElementStyle &parentStyle);
+                          const utils::ElementStyle &parentStyle,
+                          bool lazyGeometry = false);
 
 
 
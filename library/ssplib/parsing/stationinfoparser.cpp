@@ -51,6 +51,7 @@ bool StationInfoReader::parse()
     if(xml.name() != ssp_info_tags::XmlDocName)
     {
         //Not Station Info Xml
+        warning(QLatin1String("Not a station info document"));
         return false;
     }
 
@@ -70,7 +71,10 @@ bool StationInfoReader::parse()
 
     if(xml.hasError())
     {
-        qWarning() << "XML Error:" << xml.lineNumber() << xml.columnNumber() << xml.errorString();
+        if(warningCallback)
+            warningCallback(QLatin1String("XML Error: ") + xml.errorString(), xml.lineNumber());
+        else
+            qWarning() << "XML Error:" << xml.lineNumber() << xml.columnNumber() << xml.errorString();
     }
 
     return !xml.hasError();
@@ -167,22 +171,37 @@ void StationInfoReader::parseGate()
     LabelItem gate;
     QStringView name = xml.attributes().value(ssp_info_attrs::Name).trimmed();
     if(name.isEmpty())
+    {
+        warning(QLatin1String("Gate without name"));
         return;
+    }
 
     gate.gateLetter = name.front().toUpper();
     if(gate.gateLetter < 'A' || gate.gateLetter > 'Z')
-        return; //Invalid name
+    {
+        //Invalid name
+        warning(QStringLiteral("Invalid gate name \"%1\"").arg(name));
+        return;
+    }
 
     for(const LabelItem& other : std::as_const(m_plan->labels))
     {
         if(other.gateLetter == gate.gateLetter)
-            return; //Name already exist
+        {
+            //Name already exist
+            warning(QStringLiteral("Duplicate gate %1").arg(gate.gateLetter));
+            return;
+        }
     }
 
     bool ok = false;
     gate.gateOutTrkCount = xml.attributes().value(ssp_info_attrs::TrkCount).toInt(&ok);
     if(!ok || gate.gateOutTrkCount < 0 || gate.gateOutTrkCount > 255) //TODO: max track?
+    {
+        warning(QStringLiteral("Invalid track count \"%1\" for gate %2")
+                    .arg(xml.attributes().value(ssp_info_attrs::TrkCount), QString(gate.gateLetter)));
         return;
+    }
 
     QString side = xml.attributes().value(ssp_info_attrs::GateSide).toString();
     if(side == gateSideValues[int(Side::West)])
@@ -190,7 +209,11 @@ void StationInfoReader::parseGate()
     else if(side == gateSideValues[int(Side::East)])
         gate.gateSide = Side::East;
     else
-        return; //Invalid side
+    {
+        //Invalid side
+        warning(QStringLiteral("Invalid side \"%1\" for gate %2").arg(side, QString(gate.gateLetter)));
+        return;
+    }
 
     m_plan->labels.append(gate);
 }
@@ -200,24 +223,42 @@ void StationInfoReader::parseTrack()
     TrackItem track;
     QStringView name = xml.attributes().value(ssp_info_attrs::Name).trimmed();
     if(name.isEmpty())
+    {
+        warning(QLatin1String("Track without name"));
         return;
+    }
 
     track.trackName = name.toString();
 
     bool ok = false;
     track.trackPos = xml.attributes().value(ssp_info_attrs::TrackPos).toInt(&ok);
     if(!ok || track.trackPos < 0 || track.trackPos > 255) //TODO: max track?
+    {
+        warning(QStringLiteral("Invalid position \"%1\" for track %2")
+                    .arg(xml.attributes().value(ssp_info_attrs::TrackPos), track.trackName));
         return;
+    }
 
     for(const TrackItem& other : std::as_const(m_plan->platforms))
     {
         if(other.trackPos == track.trackPos || other.trackName == track.trackName)
-            return; //Name or Pos already exist
+        {
+            //Name or Pos already exist
+            warning(QStringLiteral("Duplicate track %1 at position %2, already used by track %3 at position %4")
+                        .arg(track.trackName, QString::number(track.trackPos),
+                             other.trackName, QString::number(other.trackPos)));
+            return;
+        }
     }
 
     m_plan->platforms.append(track);
 }
 
+void StationInfoReader::warning(const QString &msg)
+{
+    if(warningCallback)
+        warningCallback(msg, xml.lineNumber());
+}
 
 StationInfoWriter::StationInfoWriter(QIODevice *dev) :
     xml(dev)
@@ -3,6 +3,8 @@
 
 #include <QXmlStreamReader>
 
+#include <functional>
+
 namespace ssplib {
 
 class StationPlan;
@@ -14,14 +16,23 @@ public:
 
     bool parse();
 
+    //Called with XML errors and skipped gates or tracks, with their line number
+    //If not set XML errors are logged and invalid entries are silently skipped
+    typedef std::function<void(const QString&, qint64)> WarningCallback;
+    inline void setWarningCallback(const WarningCallback& func) { warningCallback = func; }
+
 private:
     void parseStation();
     void parseGate();
     void parseTrack();
 
+    void warning(const QString& msg);
+
 private:
     QXmlStreamReader xml;
     StationPlan *m_plan;
+
+    WarningCallback warningCallback;
 };
 
 class StationInfoWriter
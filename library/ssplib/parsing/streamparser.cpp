@@ -5,6 +5,7 @@
 #include <ssplib/stationplan.h>
 
 #include "parsinghelpers.h"
+#include <ssplib/utils/tracing.h>
 
 #include <QDebug>
 
@@ -12,13 +13,16 @@ using namespace ssplib;
 
 StreamParser::StreamParser(StationPlan *ptr, QIODevice *dev) :
     xml(dev),
-    plan(ptr)
+    plan(ptr),
+    m_lazyGeometry(false)
 {
 
 }
 
 bool StreamParser::parse()
 {
+    SSPLIB_TRACE_SCOPE("StreamParser::parse");
+
     if(!xml.readNextStartElement())
     {
         //Cannot read
@@ -28,6 +32,8 @@ bool StreamParser::parse()
     if(xml.name() != QLatin1String("svg"))
     {
         //Not SVG
+        if(warningCallback)
+            warningCallback(QLatin1String("Not an SVG document"), xml.lineNumber());
         return false;
     }
 
@@ -35,7 +41,10 @@ bool StreamParser::parse()
 
     if(xml.hasError())
     {
-        qWarning() << "XML Error:" << xml.lineNumber() << xml.columnNumber() << xml.errorString();
+        if(warningCallback)
+            warningCallback(QLatin1String("XML Error: ") + xml.errorString(), xml.lineNumber());
+        else
+            qWarning() << "XML Error:" << xml.lineNumber() << xml.columnNumber() << xml.errorString();
     }
 
     return !xml.hasError();
@@ -57,11 +66,29 @@ void StreamParser::parseGroup(const utils::ElementStyle& parentStyle)
         {
             utils::XmlElement e(xml.name(), xml.attributes());
 
-            parsing::parseLabel(e, plan->labels, elemStyle);
-            parsing::parsePlatform(e, plan->platforms, elemStyle);
-            parsing::parseTrackConnection(e, plan->trackConnections, elemStyle);
+            if(!parsing::parseLabel(e, plan->labels, elemStyle, m_lazyGeometry))
+                reportInvalidTag(svg_attr::LabelName);
+            if(!parsing::parsePlatform(e, plan->platforms, elemStyle, m_lazyGeometry))
+                reportInvalidTag(svg_attr::TrackPos);
+            if(!parsing::parseTrackConnection(e, plan->trackConnections, elemStyle, m_lazyGeometry))
+                reportInvalidTag(svg_attr::TrackConnections);
         }
 
         xml.skipCurrentElement();
     }
 }
+
+void StreamParser::reportInvalidTag(const QString &attr)
+{
+    if(!warningCallback)
+        return;
+
+    //Parse functions also fail when attribute is missing
+    const QStringView value = xml.attributes().value(attr);
+    if(value.isEmpty())
+        return;
+
+    warningCallback(QStringLiteral("Cannot parse %1 tag \"%2\" or geometry of <%3>")
+                        .arg(attr, value, xml.name()),
+                    xml.lineNumber());
+}
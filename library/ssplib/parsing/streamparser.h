@@ -3,6 +3,8 @@
 
 #include <QXmlStreamReader>
 
+#include <functional>
+
 namespace ssplib {
 
 namespace utils {
@@ -18,12 +20,24 @@ public:
 
     bool parse();
 
+    //Store raw attributes and convert geometry on first access
+    inline void setLazyGeometry(bool val) { m_lazyGeometry = val; }
+
+    //Called with XML errors and tags which cannot be parsed, with their line number
+    //If not set XML errors are logged and invalid tags are silently skipped
+    typedef std::function<void(const QString&, qint64)> WarningCallback;
+    inline void setWarningCallback(const WarningCallback& func) { warningCallback = func; }
+
 private:
     void parseGroup(const ssplib::utils::ElementStyle &parentStyle);
+    void reportInvalidTag(const QString& attr);
 
 private:
     QXmlStreamReader xml;
     StationPlan *plan;
+    bool m_lazyGeometry;
+
+    WarningCallback warningCallback;
 };
 
 } // namespace ssplib
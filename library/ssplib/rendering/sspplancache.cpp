@@ -0,0 +1,200 @@
+#include "sspplancache.h"
+
+#include <ssplib/stationplan.h>
+#include <ssplib/parsing/streamparser.h>
+
+#include <QSvgRenderer>
+#include <QXmlStreamReader>
+
+#include <QCoreApplication>
+#include <QFileInfo>
+#include <QFile>
+#include <QBuffer>
+#include <QDateTime>
+
+#include <QDebug>
+
+using namespace ssplib;
+
+SSPPlanCache *SSPPlanCache::self = nullptr;
+
+//Default memory budget, 64 MB
+static constexpr qint64 DefaultMaxCost = 64 * 1024 * 1024;
+
+SSPPlanCache::SSPPlanCache() :
+    m_cache(DefaultMaxCost),
+    m_hits(0),
+    m_misses(0)
+{
+
+}
+
+SSPPlanCache::~SSPPlanCache()
+{
+    m_cache.clear();
+}
+
+SSPPlanCache::Entry::~Entry()
+{
+    if(owner)
+        owner->m_entries.remove(this);
+}
+
+MemoryUsage SSPPlanCache::Entry::memoryUsage() const
+{
+    MemoryUsage usage = data.plan->memoryUsage();
+    usage.renderers += rendererBytes;
+    return usage;
+}
+
+SSPPlanCache *SSPPlanCache::instance()
+{
+    if(!self)
+    {
+        self = new SSPPlanCache;
+
+        //Release renderers while QCoreApplication is still alive
+        qAddPostRoutine(&SSPPlanCache::cleanup);
+    }
+    return self;
+}
+
+void SSPPlanCache::cleanup()
+{
+    delete self;
+    self = nullptr;
+}
+
+SSPCachedPlan SSPPlanCache::load(const QString &fileName)
+{
+    const QFileInfo info(fileName);
+    const QString path = info.canonicalFilePath();
+    if(path.isEmpty())
+    {
+        qWarning() << "SSPPlanCache: file does not exist" << fileName;
+        return SSPCachedPlan();
+    }
+
+    const QString key = path + QLatin1Char('|')
+                        + QString::number(info.lastModified().toMSecsSinceEpoch())
+                        + QLatin1Char('|') + QString::number(info.size());
+
+    if(Entry *entry = m_cache.object(key))
+    {
+        m_hits++;
+        return entry->data;
+    }
+
+    m_misses++;
+
+    //File was modified, drop old entry
+    const QString oldKey = m_pathKeys.take(path);
+    if(!oldKey.isEmpty())
+        m_cache.remove(oldKey);
+
+    Entry *entry = new Entry;
+    if(!loadFromFile(path, entry))
+    {
+        delete entry;
+        return SSPCachedPlan();
+    }
+
+    entry->owner = this;
+    m_entries.insert(entry);
+
+    const SSPCachedPlan data = entry->data;
+    const qint64 cost = entry->memoryUsage().total();
+
+    //If cost exceeds budget entry is deleted but data is still returned
+    if(m_cache.insert(key, entry, cost))
+        m_pathKeys.insert(path, key);
+
+    return data;
+}
+
+void SSPPlanCache::remove(const QString &fileName)
+{
+    const QString path = QFileInfo(fileName).canonicalFilePath();
+    const QString key = m_pathKeys.take(path);
+    if(!key.isEmpty())
+        m_cache.remove(key);
+}
+
+void SSPPlanCache::clear()
+{
+    m_cache.clear();
+    m_pathKeys.clear();
+}
+
+void SSPPlanCache::setMaxCost(qint64 bytes)
+{
+    m_cache.setMaxCost(bytes);
+}
+
+qint64 SSPPlanCache::maxCost() const
+{
+    return m_cache.maxCost();
+}
+
+qint64 SSPPlanCache::totalCost() const
+{
+    return m_cache.totalCost();
+}
+
+MemoryUsage SSPPlanCache::memoryUsage() const
+{
+    MemoryUsage usage;
+    for(const Entry *entry : m_entries)
+        usage += entry->memoryUsage();
+    return usage;
+}
+
+void SSPPlanCache::resetCounters()
+{
+    m_hits = 0;
+    m_misses = 0;
+}
+
+bool SSPPlanCache::loadFromFile(const QString &fileName, Entry *entry)
+{
+    QFile f(fileName);
+    if(!f.open(QFile::ReadOnly))
+    {
+        qWarning() << "SSPPlanCache: cannot open" << fileName << f.errorString();
+        return false;
+    }
+
+    //Read file once, then parse both plan and renderer from memory
+    const QByteArray content = f.readAll();
+    f.close();
+
+    QSharedPointer<StationPlan> plan(new StationPlan);
+
+    QBuffer buf;
+    buf.setData(content);
+    buf.open(QIODevice::ReadOnly);
+
+    //Geometry is converted only for items which get drawn or hit tested
+    StreamParser parser(plan.data(), &buf);
+    parser.setLazyGeometry(true);
+    if(!parser.parse())
+    {
+        qWarning() << "SSPPlanCache: parsing error" << fileName;
+        return false;
+    }
+
+    QSharedPointer<QSvgRenderer> renderer(new QSvgRenderer);
+    QXmlStreamReader xml(content);
+    if(!renderer->load(&xml))
+    {
+        qWarning() << "SSPPlanCache: SVG loading error" << fileName;
+        return false;
+    }
+
+    //QSvgRenderer does not expose its tree size, estimate it from document size
+    entry->rendererBytes = content.size();
+
+    entry->data.plan = plan;
+    entry->data.renderer = renderer;
+    return true;
+}
@@ -0,0 +1,93 @@
+#ifndef SSPLIB_SSPPLANCACHE_H
+#define SSPLIB_SSPPLANCACHE_H
+
+#include <QCache>
+#include <QHash>
+#include <QSet>
+#include <QSharedPointer>
+
+#include <ssplib/utils/memoryusage.h>
+
+class QSvgRenderer;
+
+namespace ssplib {
+
+class StationPlan;
+
+struct SSPCachedPlan
+{
+    QSharedPointer<const StationPlan> plan;
+    QSharedPointer<QSvgRenderer> renderer;
+
+    inline bool isValid() const { return plan && renderer; }
+};
+
+//Process wide LRU cache of parsed plans and loaded renderers
+//Entries are keyed by canonical file path, modification time and size
+//so a changed file is parsed again.
+//Returned plans are shared and must not be modified, use StationPlanState
+//to keep per view state. Must be used only from GUI thread.
+class SSPPlanCache
+{
+public:
+    static SSPPlanCache *instance();
+
+    //Returns cached plan or parses file, invalid result on error
+    SSPCachedPlan load(const QString& fileName);
+
+    void remove(const QString& fileName);
+    void clear();
+
+    //Memory budget in bytes
+    void setMaxCost(qint64 bytes);
+    qint64 maxCost() const;
+    qint64 totalCost() const;
+
+    //Usage of all cached plans and renderers
+    //Entries are counted again because lazy geometry grows after drawing
+    MemoryUsage memoryUsage() const;
+    inline int count() const { return m_cache.count(); }
+
+    inline qint64 hitCount() const { return m_hits; }
+    inline qint64 missCount() const { return m_misses; }
+    void resetCounters();
+
+private:
+    SSPPlanCache();
+    ~SSPPlanCache();
+
+    static void cleanup();
+
+    struct Entry
+    {
+        ~Entry();
+
+        SSPPlanCache *owner = nullptr;
+        SSPCachedPlan data;
+        qint64 rendererBytes = 0;
+
+        MemoryUsage memoryUsage() const;
+    };
+
+    static bool loadFromFile(const QString& fileName, Entry *entry);
+
+private:
+    //Live entries, iterated without touching QCache LRU order
+    //Must be declared before m_cache so it outlives it
+    QSet<Entry *> m_entries;
+
+    //Key is built from path, modification time and size
+    QCache<QString, Entry> m_cache;
+
+    //Last key of each path, to drop stale entries
+    QHash<QString, QString> m_pathKeys;
+
+    qint64 m_hits;
+    qint64 m_misses;
+
+    static SSPPlanCache *self;
+};
+
+} // namespace ssplib
+
+#endif // SSPLIB_SSPPLANCACHE_H
@@ -3,6 +3,8 @@
 #include <QPainter>
 
 #include <ssplib/stationplan.h>
+#include <ssplib/stationplanstate.h>
+#include <ssplib/utils/tracing.h>
 
 void setFontSize(QPainter *painter, const QFont& originalFont, const QRectF& originalRect, const QString& text)
 {
@@ -40,19 +42,33 @@ QTransform ssplib::SSPRenderHelper::getTranform(const QRectF &target, const QRec
     return transform;
 }
 
-void ssplib::SSPRenderHelper::drawPlan(QPainter *painter, StationPlan *plan, const QRectF& target, const QRectF& source)
+void ssplib::SSPRenderHelper::drawPlan(QPainter *painter, const StationPlan *plan, const QRectF& target, const QRectF& source)
 {
+    drawPlan(painter, plan, nullptr, target, source);
+}
+
+void ssplib::SSPRenderHelper::drawPlan(QPainter *painter, const StationPlan *plan, const StationPlanState *state,
+                                       const QRectF& target, const QRectF& source)
+{
+    SSPLIB_TRACE_SCOPE("SSPRenderHelper::drawPlan");
+
     static constexpr double PenWidthFactor = 1.5;
 
+    const bool drawLabels = state ? state->drawLabels : plan->drawLabels;
+    const bool drawTracks = state ? state->drawTracks : plan->drawTracks;
+    const QRgb labelRGB = state ? state->labelRGB : plan->labelRGB;
+    const QRgb platformRGB = state ? state->platformRGB : plan->platformRGB;
+    const qreal platformPenWidth = state ? state->platformPenWidth : plan->platformPenWidth;
+
     painter->setTransform(getTranform(target, source));
 
-    QPen trackPen(plan->platformRGB);
+    QPen trackPen(platformRGB);
     trackPen.setCapStyle(Qt::RoundCap);
 
-    painter->setPen(plan->labelRGB);
+    painter->setPen(labelRGB);
 
     //Draw labels
-    if(plan->drawLabels)
+    if(drawLabels)
     {
         QFont f;
 
@@ -62,15 +78,16 @@ void ssplib::SSPRenderHelper::drawPlan(QPainter *painter, StationPlan *plan, con
         for(int i = 0; i < count; i++)
         {
             const LabelItem &item = plan->labels.at(i);
-            if(!item.visible || item.elements.isEmpty())
+            const ItemState st = getItemState(state ? &state->labels : nullptr, i, item);
+            if(!st.visible || item.elements.isEmpty())
                 continue; //Skip it
 
             for(const auto& elem : std::as_const(item.elements))
             {
                 // Do not draw path for labels
                 // Make sure rect does not have null size
-                QRectF r = elem.path.boundingRect();
-                double minSz = qMax(elem.strokeWidth, 0.1);
+                QRectF r = elem.getPath().boundingRect();
+                double minSz = qMax(elem.getStrokeWidth(), 0.1);
                 r.setSize(QSize(qMax(minSz, r.width()), qMax(minSz, r.height())));
 
                 QString text = item.labelText;
@@ -85,51 +102,53 @@ void ssplib::SSPRenderHelper::drawPlan(QPainter *painter, StationPlan *plan, con
     }
 
     //Draw tracks
-    if(plan->drawTracks)
+    if(drawTracks)
     {
         for(int i = 0; i < plan->platforms.count(); i++)
         {
             const TrackItem &item = plan->platforms.at(i);
-            if(!item.visible || item.elements.isEmpty())
+            const ItemState st = getItemState(state ? &state->platforms : nullptr, i, item, item.color);
+            if(!st.visible || item.elements.isEmpty())
                 continue; //Skip it
 
-            if(item.color == whiteRGB)
-                trackPen.setColor(plan->platformRGB);
+            if(st.color == whiteRGB)
+                trackPen.setColor(platformRGB);
             else
-                trackPen.setColor(item.color);
+                trackPen.setColor(st.color);
 
             for(const auto& elem : std::as_const(item.elements))
             {
-                if(elem.strokeWidth == 0)
-                    trackPen.setWidth(plan->platformPenWidth);
+                if(elem.getStrokeWidth() == 0)
+                    trackPen.setWidth(platformPenWidth);
                 else
-                    trackPen.setWidthF(elem.strokeWidth * PenWidthFactor);
+                    trackPen.setWidthF(elem.getStrokeWidth() * PenWidthFactor);
                 painter->setPen(trackPen);
 
-                painter->drawPath(elem.path);
+                painter->drawPath(elem.getPath());
             }
         }
 
         for(int i = 0; i < plan->trackConnections.count(); i++)
         {
             const TrackConnectionItem &item = plan->trackConnections.at(i);
-            if(!item.visible || item.elements.isEmpty())
+            const ItemState st = getItemState(state ? &state->trackConnections : nullptr, i, item, item.color);
+            if(!st.visible || item.elements.isEmpty())
                 continue; //Skip it
 
-            if(item.color == whiteRGB)
-                trackPen.setColor(plan->platformRGB);
+            if(st.color == whiteRGB)
+                trackPen.setColor(platformRGB);
             else
-                trackPen.setColor(item.color);
+                trackPen.setColor(st.color);
 
             for(const auto& elem : std::as_const(item.elements))
             {
-                if(elem.strokeWidth == 0)
-                    trackPen.setWidth(plan->platformPenWidth);
+                if(elem.getStrokeWidth() == 0)
+                    trackPen.setWidth(platformPenWidth);
                 else
-                    trackPen.setWidthF(elem.strokeWidth * PenWidthFactor);
+                    trackPen.setWidthF(elem.getStrokeWidth() * PenWidthFactor);
                 painter->setPen(trackPen);
 
-                painter->drawPath(elem.path);
+                painter->drawPath(elem.getPath());
             }
         }
     }
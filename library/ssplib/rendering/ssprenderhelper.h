@@ -8,13 +8,18 @@ class QTransform;
 namespace ssplib {
 
 class StationPlan;
+class StationPlanState;
 
 class SSPRenderHelper
 {
 public:
     static QTransform getTranform(const QRectF &target, const QRectF &source);
 
-    static void drawPlan(QPainter *painter, StationPlan *plan,
+    static void drawPlan(QPainter *painter, const StationPlan *plan,
+                         const QRectF &target, const QRectF &source);
+
+    //Draw using per view state overlay, if state is null use plan items state
+    static void drawPlan(QPainter *painter, const StationPlan *plan, const StationPlanState *state,
                          const QRectF &target, const QRectF &source);
 };
 
@@ -5,7 +5,9 @@
 #include <QPainter>
 
 #include <ssplib/stationplan.h>
+#include <ssplib/stationplanstate.h>
 #include "ssprenderhelper.h"
+#include <ssplib/utils/tracing.h>
 
 #include <QMouseEvent>
 #include <QHelpEvent>
@@ -13,9 +15,10 @@
 
 using namespace ssplib;
 
-SSPViewer::SSPViewer(StationPlan *mgr, QWidget *parent) :
+SSPViewer::SSPViewer(const StationPlan *mgr, QWidget *parent) :
     QWidget(parent),
     m_plan(mgr),
+    m_state(nullptr),
     mSvg(nullptr)
 {
     setBackgroundRole(QPalette::Light);
@@ -33,21 +36,37 @@ void SSPViewer::setRenderer(QSvgRenderer *svg)
     mSvg = svg;
 }
 
-void SSPViewer::setPlan(StationPlan *newPlan)
+void SSPViewer::setPlan(const StationPlan *newPlan)
 {
     m_plan = newPlan;
 }
 
+void SSPViewer::setPlanState(StationPlanState *state)
+{
+    m_state = state;
+}
+
 const ItemBase *SSPViewer::findItemAtPos(const QPointF &scenePos, FindItemType &outType) const
 {
+    SSPLIB_TRACE_SCOPE("SSPViewer::findItemAtPos");
+
+    //Only items which are drawn can be found, so lazy geometry of hidden items
+    //is never converted just for hit testing
+    const bool drawLabels = m_state ? m_state->drawLabels : m_plan->drawLabels;
+    const bool drawTracks = m_state ? m_state->drawTracks : m_plan->drawTracks;
+
     //First try with labels
-    for(const LabelItem& label : std::as_const(m_plan->labels))
+    for(int i = 0; drawLabels && i < m_plan->labels.size(); i++)
     {
+        const LabelItem& label = m_plan->labels.at(i);
+        if(!getItemState(m_state ? &m_state->labels : nullptr, i, label).visible)
+            continue;
+
         for(const ElementPath& elem : label.elements)
         {
             // Make sure rect does not have null size
-            QRectF bounds = elem.path.boundingRect();
-            double minSz = qMax(elem.strokeWidth, 0.1);
+            QRectF bounds = elem.getPath().boundingRect();
+            double minSz = qMax(elem.getStrokeWidth(), 0.1);
             bounds.setSize(QSize(qMax(minSz, bounds.width()), qMax(minSz, bounds.height())));
 
             if(bounds.contains(scenePos))
@@ -59,14 +78,19 @@ const ItemBase *SSPViewer::findItemAtPos(const QPointF &scenePos, FindItemType &
     }
 
     //Then try with station tracks
-    for(const TrackItem& track : std::as_const(m_plan->platforms))
+    for(int i = 0; drawTracks && i < m_plan->platforms.size(); i++)
     {
+        const TrackItem& track = m_plan->platforms.at(i);
+        if(!getItemState(m_state ? &m_state->platforms : nullptr, i, track).visible)
+            continue;
+
         for(const ElementPath& elem : track.elements)
         {
-            const double halfWidth = elem.strokeWidth / 2;
-            QRectF r(scenePos.x() - halfWidth, scenePos.y() - halfWidth, elem.strokeWidth, elem.strokeWidth);
+            const double strokeWidth = elem.getStrokeWidth();
+            const double halfWidth = strokeWidth / 2;
+            QRectF r(scenePos.x() - halfWidth, scenePos.y() - halfWidth, strokeWidth, strokeWidth);
 
-            if(elem.path.intersects(r))
+            if(elem.getPath().intersects(r))
             {
                 outType = FindItemType::StationTrack;
                 return &track;
@@ -75,36 +99,26 @@ const ItemBase *SSPViewer::findItemAtPos(const QPointF &scenePos, FindItemType &
     }
 
     //Then try with track connections
-    const TrackConnectionItem *possibleTrack = nullptr;
-    for(const TrackConnectionItem& track : std::as_const(m_plan->trackConnections))
+    for(int i = 0; drawTracks && i < m_plan->trackConnections.size(); i++)
     {
+        const TrackConnectionItem& track = m_plan->trackConnections.at(i);
+        if(!getItemState(m_state ? &m_state->trackConnections : nullptr, i, track).visible)
+            continue;
+
         for(const ElementPath& elem : track.elements)
         {
-            const double halfWidth = elem.strokeWidth / 2;
-            QRectF r(scenePos.x() - halfWidth, scenePos.y() - halfWidth, elem.strokeWidth, elem.strokeWidth);
+            const double strokeWidth = elem.getStrokeWidth();
+            const double halfWidth = strokeWidth / 2;
+            QRectF r(scenePos.x() - halfWidth, scenePos.y() - halfWidth, strokeWidth, strokeWidth);
 
-            if(elem.path.intersects(r))
+            if(elem.getPath().intersects(r))
             {
-                if(possibleTrack)
-                {
-                    //Prefer visible track if we get multiple matches
-                    if(!possibleTrack->visible && track.visible)
-                        possibleTrack = &track;
-                }
-                else
-                {
-                    possibleTrack = &track;
-                }
+                outType = FindItemType::TrackConnection;
+                return &track;
             }
         }
     }
 
-    if(possibleTrack)
-    {
-        outType = FindItemType::TrackConnection;
-        return possibleTrack;
-    }
-
     outType = FindItemType::NotFound;
     return nullptr;
 }
@@ -173,6 +187,8 @@ bool ssplib::SSPViewer::event(QEvent *e)
 
 void SSPViewer::paintEvent(QPaintEvent *)
 {
+    SSPLIB_TRACE_SCOPE("SSPViewer::paintEvent");
+
     const QRectF target = rect();
     const QRectF source = mSvg ? mSvg->viewBoxF() : target;
 
@@ -182,7 +198,7 @@ void SSPViewer::paintEvent(QPaintEvent *)
         mSvg->render(&p, target);
 
     if(m_plan)
-        SSPRenderHelper::drawPlan(&p, m_plan, target, source);
+        SSPRenderHelper::drawPlan(&p, m_plan, m_state, target, source);
 }
 
 void SSPViewer::mouseDoubleClickEvent(QMouseEvent *e)
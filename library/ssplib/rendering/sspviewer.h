@@ -8,6 +8,7 @@ class QSvgRenderer;
 namespace ssplib {
 
 class StationPlan;
+class StationPlanState;
 struct ItemBase;
 
 class SSPViewer : public QWidget
@@ -15,13 +16,17 @@ class SSPViewer : public QWidget
     Q_OBJECT
 
 public:
-    explicit SSPViewer(StationPlan *plan, QWidget *parent = nullptr);
+    explicit SSPViewer(const StationPlan *plan, QWidget *parent = nullptr);
 
     QSize sizeHint() const override;
 
     void setRenderer(QSvgRenderer *svg);
 
-    void setPlan(StationPlan *newPlan);
+    void setPlan(const StationPlan *newPlan);
+
+    //Per view item state, if null state is taken from plan items
+    void setPlanState(StationPlanState *state);
+    inline StationPlanState *planState() const { return m_state; }
 
     enum class FindItemType
     {
@@ -31,6 +36,7 @@ public:
         TrackConnection
     };
 
+    //Only visible items of drawn layers are found
     const ItemBase *findItemAtPos(const QPointF &scenePos, FindItemType &outType) const;
 
 signals:
@@ -47,7 +53,8 @@ protected:
     void mouseDoubleClickEvent(QMouseEvent *e) override;
 
 protected:
-    StationPlan *m_plan;
+    const StationPlan *m_plan;
+    StationPlanState *m_state;
 
     QSvgRenderer *mSvg;
 };
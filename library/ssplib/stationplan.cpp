@@ -1,5 +1,9 @@
 #include "stationplan.h"
 
+#include "parsing/lazygeometry.h"
+
+#include <QSet>
+
 using namespace ssplib;
 
 StationPlan::StationPlan() :
@@ -23,3 +27,59 @@ void StationPlan::clear()
     trackConnections.clear();
     trackConnections.squeeze();
 }
+
+MemoryUsage StationPlan::memoryUsage() const
+{
+    MemoryUsage usage;
+
+    //Lazy geometry is shared between copies of same element, count it once
+    QSet<const LazyElementGeometry *> countedGeometry;
+
+    auto countElements = [&usage, &countedGeometry](const ItemBase& item)
+    {
+        usage.itemLists += qint64(item.elements.capacity()) * qint64(sizeof(ElementPath));
+
+        for(const ElementPath& elem : item.elements)
+        {
+            if(!elem.lazy)
+            {
+                usage.elementPaths += utils::pathBytes(elem.path);
+                continue;
+            }
+
+            if(countedGeometry.contains(elem.lazy.data()))
+                continue;
+            countedGeometry.insert(elem.lazy.data());
+
+            usage.elementPaths += qint64(sizeof(LazyElementGeometry))
+                                  + elem.lazy->rawBytes + utils::pathBytes(elem.lazy->path);
+        }
+    };
+
+    usage.itemLists += qint64(labels.capacity()) * qint64(sizeof(LabelItem));
+    usage.itemLists += qint64(platforms.capacity()) * qint64(sizeof(TrackItem));
+    usage.itemLists += qint64(trackConnections.capacity()) * qint64(sizeof(TrackConnectionItem));
+
+    usage.strings += utils::stringBytes(stationName);
+
+    for(const LabelItem& item : labels)
+    {
+        countElements(item);
+        usage.strings += utils::stringBytes(item.labelText);
+    }
+
+    for(const TrackItem& item : platforms)
+    {
+        countElements(item);
+        usage.strings += utils::stringBytes(item.trackName);
+        usage.strings += utils::stringBytes(item.tooltip);
+    }
+
+    for(const TrackConnectionItem& item : trackConnections)
+    {
+        countElements(item);
+        usage.strings += utils::stringBytes(item.tooltip);
+    }
+
+    return usage;
+}
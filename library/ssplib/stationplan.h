@@ -2,11 +2,14 @@
 #define SSPLIB_STATIONPLAN_H
 
 #include "itemtypes.h"
+#include "utils/memoryusage.h"
 
 #include <QRgb>
 
 namespace ssplib {
 
+//Item lists are implicitly shared so a plan can be shared by many viewers
+//Per view visibility and colors are stored in StationPlanState
 class StationPlan
 {
 public:
@@ -14,6 +17,8 @@ public:
 
     void clear();
 
+    MemoryUsage memoryUsage() const;
+
 public:
     QList<LabelItem> labels;
     QList<TrackItem> platforms;
@@ -0,0 +1,92 @@
+#include "stationplanstate.h"
+
+#include "stationplan.h"
+
+using namespace ssplib;
+
+StationPlanState::StationPlanState() :
+    drawLabels(true),
+    drawTracks(true),
+    labelRGB(qRgb(0, 0, 255)),
+    platformRGB(qRgb(255, 0, 0)),
+    platformPenWidth(10)
+{
+
+}
+
+void StationPlanState::reset(const StationPlan *plan)
+{
+    clear();
+
+    labels.reserve(plan->labels.size());
+    for(const LabelItem& item : plan->labels)
+        labels.append(getItemState(nullptr, 0, item));
+
+    platforms.reserve(plan->platforms.size());
+    for(const TrackItem& item : plan->platforms)
+        platforms.append(getItemState(nullptr, 0, item, item.color));
+
+    trackConnections.reserve(plan->trackConnections.size());
+    for(const TrackConnectionItem& item : plan->trackConnections)
+        trackConnections.append(getItemState(nullptr, 0, item, item.color));
+
+    drawLabels = plan->drawLabels;
+    drawTracks = plan->drawTracks;
+    labelRGB = plan->labelRGB;
+    platformRGB = plan->platformRGB;
+    platformPenWidth = plan->platformPenWidth;
+}
+
+void StationPlanState::clear()
+{
+    labels.clear();
+    platforms.clear();
+    trackConnections.clear();
+}
+
+void StationPlanState::setAllVisible(bool val)
+{
+    for(ItemState& st : labels)
+        st.visible = val;
+    for(ItemState& st : platforms)
+        st.visible = val;
+    for(ItemState& st : trackConnections)
+        st.visible = val;
+}
+
+void StationPlanState::showRoute(const StationTopology::Route &route, QRgb color)
+{
+    for(const StationTopology::ItemRef& ref : route.items)
+    {
+        QList<ItemState> *states = nullptr;
+        switch (ref.type)
+        {
+        case StationTopology::ItemType::Label:
+            states = &labels;
+            break;
+        case StationTopology::ItemType::Platform:
+            states = &platforms;
+            break;
+        case StationTopology::ItemType::TrackConnection:
+            states = &trackConnections;
+            break;
+        default:
+            break;
+        }
+
+        if(!states || ref.itemIdx < 0 || ref.itemIdx >= states->size())
+            continue;
+
+        ItemState& st = (*states)[ref.itemIdx];
+        st.visible = true;
+        st.color = color;
+    }
+}
+
+MemoryUsage StationPlanState::memoryUsage() const
+{
+    MemoryUsage usage;
+    usage.itemLists = qint64(labels.capacity() + platforms.capacity() + trackConnections.capacity())
+                      * qint64(sizeof(ItemState));
+    return usage;
+}
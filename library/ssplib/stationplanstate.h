@@ -0,0 +1,64 @@
+#ifndef SSPLIB_STATIONPLANSTATE_H
+#define SSPLIB_STATIONPLANSTATE_H
+
+#include "itemtypes.h"
+#include "stationtopology.h"
+#include "utils/memoryusage.h"
+
+#include <QList>
+
+namespace ssplib {
+
+class StationPlan;
+
+//Per view overlay of a StationPlan
+//The plan only holds parsed geometry and metadata so it can be shared
+//by many viewers, each one keeping its own visibility, colors and drawing settings.
+//Item states are stored by index and match plan item lists.
+class StationPlanState
+{
+public:
+    StationPlanState();
+
+    //Resize state arrays to match plan items and copy plan defaults
+    void reset(const StationPlan *plan);
+
+    void clear();
+
+    void setAllVisible(bool val);
+
+    //Show all items of route with given color, other items are not changed
+    void showRoute(const StationTopology::Route& route, QRgb color);
+
+    MemoryUsage memoryUsage() const;
+
+public:
+    QList<ItemState> labels;
+    QList<ItemState> platforms;
+    QList<ItemState> trackConnections;
+
+public:
+    bool drawLabels;
+    bool drawTracks;
+
+    QRgb labelRGB;
+    QRgb platformRGB;
+    qreal platformPenWidth;
+};
+
+//If states is null, state is taken from item itself
+inline ItemState getItemState(const QList<ItemState> *states, int idx,
+                              const ItemBase &item, QRgb itemColor = whiteRGB)
+{
+    if(states)
+        return states->value(idx); //Out of range items are not visible
+
+    ItemState st;
+    st.visible = item.visible;
+    st.color = itemColor;
+    return st;
+}
+
+} // namespace ssplib
+
+#endif // SSPLIB_STATIONPLANSTATE_H
@@ -0,0 +1,328 @@
+#include "stationtopology.h"
+
+#include "stationplan.h"
+
+#include <QLineF>
+#include <QPainterPath>
+
+#include <queue>
+#include <vector>
+#include <limits>
+#include <cmath>
+
+using namespace ssplib;
+
+//Calls func(start, end, length) for each sub path
+//Curves are measured on their control polygon, length is only used as route weight
+template <typename Func>
+static void forEachSubPath(const QPainterPath& path, Func func)
+{
+    QPointF start;
+    QPointF last;
+    qreal length = 0;
+    bool hasSegment = false;
+
+    const int count = path.elementCount();
+    for(int i = 0; i < count; i++)
+    {
+        const QPainterPath::Element e = path.elementAt(i);
+        const QPointF pt = e;
+
+        if(e.type == QPainterPath::MoveToElement)
+        {
+            if(hasSegment)
+                func(start, last, length);
+
+            start = last = pt;
+            length = 0;
+            hasSegment = false;
+            continue;
+        }
+
+        length += QLineF(last, pt).length();
+        last = pt;
+        hasSegment = true;
+    }
+
+    if(hasSegment)
+        func(start, last, length);
+}
+
+StationTopology::StationTopology() :
+    m_tolerance(1)
+{
+
+}
+
+void StationTopology::build(const StationPlan *plan, qreal tolerance)
+{
+    if(tolerance <= 0)
+    {
+        //Elements touch if their strokes overlap
+        for(const TrackItem& item : plan->platforms)
+        {
+            for(const ElementPath& p : item.elements)
+                tolerance = qMax(tolerance, p.getStrokeWidth());
+        }
+        for(const TrackConnectionItem& item : plan->trackConnections)
+        {
+            for(const ElementPath& p : item.elements)
+                tolerance = qMax(tolerance, p.getStrokeWidth());
+        }
+
+        if(tolerance <= 0)
+            tolerance = plan->platformPenWidth;
+    }
+
+    reset(tolerance);
+
+    for(int i = 0; i < plan->platforms.size(); i++)
+    {
+        const TrackItem& item = plan->platforms.at(i);
+        for(int elemIdx = 0; elemIdx < item.elements.size(); elemIdx++)
+            addSegments({ItemType::Platform, i}, elemIdx, item.elements.at(elemIdx).getPath());
+    }
+
+    for(int i = 0; i < plan->trackConnections.size(); i++)
+    {
+        const TrackConnectionItem& item = plan->trackConnections.at(i);
+        for(int elemIdx = 0; elemIdx < item.elements.size(); elemIdx++)
+            addSegments({ItemType::TrackConnection, i}, elemIdx, item.elements.at(elemIdx).getPath());
+    }
+
+    //Attach labels after all junctions are known
+    for(int i = 0; i < plan->labels.size(); i++)
+    {
+        QRectF bounds;
+        for(const ElementPath& p : plan->labels.at(i).elements)
+            bounds = bounds.united(p.getPath().boundingRect());
+
+        if(!bounds.isNull())
+            attachLabel(i, bounds);
+    }
+}
+
+void StationTopology::clear()
+{
+    m_segments.clear();
+    m_junctions.clear();
+    m_cells.clear();
+    for(QList<QList<int>>& list : m_itemSegments)
+        list.clear();
+    m_labelJunctions.clear();
+}
+
+void StationTopology::reset(qreal tolerance)
+{
+    clear();
+    m_tolerance = qMax(tolerance, qreal(1));
+}
+
+void StationTopology::addSegments(const ItemRef &item, int elemIdx, const QPainterPath &path)
+{
+    if(item.itemIdx < 0 || item.type == ItemType::Label || item.type == ItemType::NItemTypes)
+        return;
+
+    QList<QList<int>>& itemSegments = m_itemSegments[int(item.type)];
+    if(itemSegments.size() <= item.itemIdx)
+        itemSegments.resize(item.itemIdx + 1);
+
+    forEachSubPath(path, [&](const QPointF& start, const QPointF& end, qreal length)
+                   {
+                       Segment seg;
+                       seg.item = item;
+                       seg.elemIdx = elemIdx;
+                       seg.length = length;
+                       seg.junctions[0] = addJunction(start);
+                       seg.junctions[1] = addJunction(end);
+
+                       const int segIdx = m_segments.size();
+                       m_segments.append(seg);
+                       itemSegments[item.itemIdx].append(segIdx);
+
+                       m_junctions[seg.junctions[0]].segments.append(segIdx);
+                       if(seg.junctions[1] != seg.junctions[0])
+                           m_junctions[seg.junctions[1]].segments.append(segIdx);
+                   });
+}
+
+void StationTopology::attachLabel(int labelIdx, const QRectF &bounds)
+{
+    if(m_labelJunctions.size() <= labelIdx)
+        m_labelJunctions.resize(labelIdx + 1);
+
+    const QRectF area = bounds.adjusted(-m_tolerance, -m_tolerance, m_tolerance, m_tolerance);
+
+    const int x1 = int(std::floor(area.left() / m_tolerance));
+    const int x2 = int(std::floor(area.right() / m_tolerance));
+    const int y1 = int(std::floor(area.top() / m_tolerance));
+    const int y2 = int(std::floor(area.bottom() / m_tolerance));
+
+    for(int x = x1; x <= x2; x++)
+    {
+        for(int y = y1; y <= y2; y++)
+        {
+            const quint64 key = cellKey(x, y);
+            for(auto it = m_cells.constFind(key); it != m_cells.cend() && it.key() == key; ++it)
+            {
+                if(!area.contains(m_junctions.at(it.value()).pos))
+                    continue;
+
+                m_junctions[it.value()].labels.append(labelIdx);
+                m_labelJunctions[labelIdx].append(it.value());
+            }
+        }
+    }
+}
+
+QList<int> StationTopology::segmentsOfItem(const ItemRef &item) const
+{
+    if(item.type == ItemType::Label || item.type == ItemType::NItemTypes)
+        return QList<int>();
+    return m_itemSegments[int(item.type)].value(item.itemIdx);
+}
+
+StationTopology::Route StationTopology::findRoute(const ItemRef &from, const ItemRef &to) const
+{
+    Route route;
+
+    const QList<int> sources = junctionsOfItem(from);
+    const QList<int> targets = junctionsOfItem(to);
+    if(sources.isEmpty() || targets.isEmpty())
+        return route;
+
+    if(from == to)
+    {
+        route.items.append(from);
+        return route;
+    }
+
+    //Dijkstra on junctions, segments are edges
+    const qreal Infinite = std::numeric_limits<qreal>::infinity();
+    QList<qreal> dist(m_junctions.size(), Infinite);
+    QList<int> prevSegment(m_junctions.size(), -1);
+    QList<bool> isTarget(m_junctions.size(), false);
+    for(int j : targets)
+        isTarget[j] = true;
+
+    typedef std::pair<qreal, int> QueueEntry;
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> queue;
+    for(int j : sources)
+    {
+        dist[j] = 0;
+        queue.push({0, j});
+    }
+
+    int reached = -1;
+    while(!queue.empty())
+    {
+        const QueueEntry top = queue.top();
+        queue.pop();
+
+        const int j = top.second;
+        if(top.first > dist.at(j))
+            continue; //Stale entry
+
+        if(isTarget.at(j))
+        {
+            reached = j;
+            break;
+        }
+
+        for(int segIdx : m_junctions.at(j).segments)
+        {
+            const Segment& seg = m_segments.at(segIdx);
+            const int other = seg.junctions[0] == j ? seg.junctions[1] : seg.junctions[0];
+            const qreal d = top.first + seg.length;
+            if(d < dist.at(other))
+            {
+                dist[other] = d;
+                prevSegment[other] = segIdx;
+                queue.push({d, other});
+            }
+        }
+    }
+
+    if(reached < 0)
+        return route; //Not connected
+
+    route.length = dist.at(reached);
+
+    //Walk back to source
+    for(int j = reached; prevSegment.at(j) >= 0;)
+    {
+        const int segIdx = prevSegment.at(j);
+        route.segments.prepend(segIdx);
+
+        const Segment& seg = m_segments.at(segIdx);
+        j = seg.junctions[0] == j ? seg.junctions[1] : seg.junctions[0];
+    }
+
+    route.items.append(from);
+    for(int segIdx : std::as_const(route.segments))
+    {
+        const ItemRef& item = m_segments.at(segIdx).item;
+        if(!route.items.contains(item))
+            route.items.append(item);
+    }
+    if(!route.items.contains(to))
+        route.items.append(to);
+
+    return route;
+}
+
+int StationTopology::addJunction(const QPointF &pos)
+{
+    const int cx = int(std::floor(pos.x() / m_tolerance));
+    const int cy = int(std::floor(pos.y() / m_tolerance));
+
+    //Snap to nearest junction in neighbour cells
+    int best = -1;
+    qreal bestDist = m_tolerance;
+    for(int x = cx - 1; x <= cx + 1; x++)
+    {
+        for(int y = cy - 1; y <= cy + 1; y++)
+        {
+            const quint64 key = cellKey(x, y);
+            for(auto it = m_cells.constFind(key); it != m_cells.cend() && it.key() == key; ++it)
+            {
+                const qreal d = QLineF(pos, m_junctions.at(it.value()).pos).length();
+                if(d <= bestDist)
+                {
+                    best = it.value();
+                    bestDist = d;
+                }
+            }
+        }
+    }
+
+    if(best >= 0)
+        return best;
+
+    Junction junction;
+    junction.pos = pos;
+
+    const int idx = m_junctions.size();
+    m_junctions.append(junction);
+    m_cells.insert(cellKey(cx, cy), idx);
+    return idx;
+}
+
+QList<int> StationTopology::junctionsOfItem(const ItemRef &item) const
+{
+    if(item.type == ItemType::Label)
+        return m_labelJunctions.value(item.itemIdx);
+
+    QList<int> result;
+    for(int segIdx : segmentsOfItem(item))
+    {
+        const Segment& seg = m_segments.at(segIdx);
+        for(int j : seg.junctions)
+        {
+            if(!result.contains(j))
+                result.append(j);
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,112 @@
+#ifndef SSPLIB_STATIONTOPOLOGY_H
+#define SSPLIB_STATIONTOPOLOGY_H
+
+#include <QList>
+#include <QMultiHash>
+#include <QPointF>
+#include <QRectF>
+
+class QPainterPath;
+
+namespace ssplib {
+
+class StationPlan;
+
+//Connectivity graph of station plan tracks
+//Each sub path of platform and track connection elements is a segment.
+//Segment end points closer than tolerance are snapped to the same junction.
+//Labels (gates) are attached to junctions inside their bounds.
+//Graph can also be built incrementally with elements not yet assigned to items.
+class StationTopology
+{
+public:
+    enum class ItemType : qint8
+    {
+        Label = 0,
+        Platform,
+        TrackConnection,
+        Element, //Free element, item index is chosen by caller
+        NItemTypes
+    };
+
+    struct ItemRef
+    {
+        ItemType type = ItemType::Platform;
+        int itemIdx = -1;
+
+        inline bool operator==(const ItemRef& other) const
+        {
+            return type == other.type && itemIdx == other.itemIdx;
+        }
+    };
+
+    struct Segment
+    {
+        ItemRef item;
+        int elemIdx = -1;
+        int junctions[2] = {-1, -1};
+        qreal length = 0;
+    };
+
+    struct Junction
+    {
+        QPointF pos;
+        QList<int> segments;
+        QList<int> labels; //Label item indexes
+    };
+
+    //Items traversed by a route, in route order
+    struct Route
+    {
+        QList<int> segments;
+        QList<ItemRef> items;
+        qreal length = 0;
+
+        inline bool isValid() const { return !items.isEmpty(); }
+    };
+
+    StationTopology();
+
+    //Tolerance <= 0 means use max stroke width of plan elements
+    void build(const StationPlan *plan, qreal tolerance = 0);
+    void clear();
+
+    //Incremental building, add all segments before attaching labels
+    void reset(qreal tolerance);
+    void addSegments(const ItemRef& item, int elemIdx, const QPainterPath& path);
+    void attachLabel(int labelIdx, const QRectF& bounds);
+
+    QList<int> segmentsOfItem(const ItemRef& item) const;
+    QList<int> junctionsOfItem(const ItemRef& item) const;
+
+    inline const QList<Segment>& segments() const { return m_segments; }
+    inline const QList<Junction>& junctions() const { return m_junctions; }
+    inline qreal tolerance() const { return m_tolerance; }
+
+    //Shortest route between two items, invalid if not connected
+    Route findRoute(const ItemRef& from, const ItemRef& to) const;
+
+private:
+    int addJunction(const QPointF& pos);
+
+    inline quint64 cellKey(int x, int y) const
+    {
+        return (quint64(quint32(x)) << 32) | quint64(quint32(y));
+    }
+
+private:
+    QList<Segment> m_segments;
+    QList<Junction> m_junctions;
+
+    //Spatial hash of junctions, cell size equals tolerance
+    QMultiHash<quint64, int> m_cells;
+    qreal m_tolerance;
+
+    //Segments of each item by type, indexed by item list position
+    QList<QList<int>> m_itemSegments[int(ItemType::NItemTypes)];
+    QList<QList<int>> m_labelJunctions;
+};
+
+} // namespace ssplib
+
+#endif // SSPLIB_STATIONTOPOLOGY_H
@@ -2,7 +2,10 @@
 #define SSPLIB_SVGSTATIONPLANLIB_H
 
 #include "stationplan.h"
+#include "stationplanstate.h"
+#include "stationtopology.h"
 #include "rendering/sspviewer.h"
+#include "rendering/sspplancache.h"
 #include "parsing/streamparser.h"
 
 #endif // SSPLIB_SVGSTATIONPLANLIB_H
@@ -0,0 +1,40 @@
+#include "memoryusage.h"
+
+#include <QString>
+#include <QPainterPath>
+#include <QLocale>
+
+using namespace ssplib;
+
+MemoryUsage &MemoryUsage::operator+=(const MemoryUsage &other)
+{
+    itemLists += other.itemLists;
+    elementPaths += other.elementPaths;
+    strings += other.strings;
+    rasters += other.rasters;
+    renderers += other.renderers;
+    return *this;
+}
+
+QString MemoryUsage::toString() const
+{
+    const QLocale l = QLocale::c();
+    QString str;
+    str += QLatin1String("Item lists:    ") + l.formattedDataSize(itemLists) + QLatin1Char('\n');
+    str += QLatin1String("Element paths: ") + l.formattedDataSize(elementPaths) + QLatin1Char('\n');
+    str += QLatin1String("Strings:       ") + l.formattedDataSize(strings) + QLatin1Char('\n');
+    str += QLatin1String("Rasters:       ") + l.formattedDataSize(rasters) + QLatin1Char('\n');
+    str += QLatin1String("Renderers:     ") + l.formattedDataSize(renderers) + QLatin1Char('\n');
+    str += QLatin1String("Total:         ") + l.formattedDataSize(total());
+    return str;
+}
+
+qint64 utils::stringBytes(const QString &str)
+{
+    return qint64(str.capacity()) * qint64(sizeof(QChar));
+}
+
+qint64 utils::pathBytes(const QPainterPath &path)
+{
+    return qint64(path.elementCount()) * qint64(sizeof(QPainterPath::Element));
+}
@@ -0,0 +1,41 @@
+#ifndef SSPLIB_MEMORYUSAGE_H
+#define SSPLIB_MEMORYUSAGE_H
+
+#include <QtGlobal>
+
+class QString;
+class QPainterPath;
+
+namespace ssplib {
+
+//Approximate heap usage in bytes, broken down by category
+//Qt private data overhead is not included
+struct MemoryUsage
+{
+    qint64 itemLists = 0;    //Item structs and element list storage
+    qint64 elementPaths = 0; //Path elements and lazy raw attributes
+    qint64 strings = 0;      //Names, labels and tooltips
+    qint64 rasters = 0;      //Cached images
+    qint64 renderers = 0;    //Estimated QSvgRenderer trees
+
+    inline qint64 total() const
+    {
+        return itemLists + elementPaths + strings + rasters + renderers;
+    }
+
+    MemoryUsage& operator+=(const MemoryUsage& other);
+
+    //Human readable breakdown, one category per line
+    QString toString() const;
+};
+
+namespace utils {
+
+qint64 stringBytes(const QString& str);
+qint64 pathBytes(const QPainterPath& path);
+
+} // namespace utils
+
+} // namespace ssplib
+
+#endif // SSPLIB_MEMORYUSAGE_H
@@ -1,9 +1,12 @@
 #include "svg_path_utils.h"
 
 #include "svg_constants.h"
+#include "tracing.h"
 
 #include <QTextStream>
 
+#include <limits>
+
 #include <QDebug>
 
 using namespace ssplib;
@@ -117,8 +120,11 @@ static int parseInteger(const QString& str, int &pos)
     {
         if(str.at(pos).isDigit())
         {
-            val *= 10;
-            val += str.at(pos).digitValue();
+            //Saturate instead of overflowing on very long numbers
+            if(val > (std::numeric_limits<int>::max() - 9) / 10)
+                val = std::numeric_limits<int>::max();
+            else
+                val = val * 10 + str.at(pos).digitValue();
         }
 
         if(str.at(pos) == ',' || str.at(pos) == ')')
@@ -200,6 +206,8 @@ static bool convertPath(const utils::XmlElement &e, QPainterPath &path)
 
     //Skip leading spaces
     strRef = strRef.trimmed();
+    if(strRef.isEmpty())
+        return false;
 
     bool defaultRelative = false;
     QChar startLetter = strRef.at(0);
@@ -395,6 +403,8 @@ bool utils::parsePointAndAdvance(QPointF &outPoint, QStringView &str)
 
 bool utils::convertElementToPath(const utils::XmlElement &e, QPainterPath &path)
 {
+    SSPLIB_TRACE_SCOPE("convertElementToPath");
+
     if(e.tagName() == svg_tags::LineTag)
     {
         return convertLine(e, path);
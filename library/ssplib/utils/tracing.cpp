@@ -0,0 +1,162 @@
+#include "tracing.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QFile>
+#include <QList>
+#include <QThread>
+
+#include <QDebug>
+
+using namespace ssplib::utils;
+
+namespace ssplib {
+namespace utils {
+Q_LOGGING_CATEGORY(lcTrace, "ssplib.trace", QtWarningMsg)
+} // namespace utils
+} // namespace ssplib
+
+//Stop collecting after this many events to bound memory
+static constexpr int MaxEvents = 4 * 1024 * 1024;
+
+namespace {
+
+struct TraceEvent
+{
+    const char *name;
+    const char *category;
+    qint64 start;
+    qint64 duration;
+    quint64 threadId;
+};
+
+//Events are written when last reference goes away at exit
+struct TraceData
+{
+    TraceData()
+    {
+        timer.start();
+        fileName = qEnvironmentVariable("SSPLIB_TRACE_FILE", QLatin1String("ssplib-trace.json"));
+    }
+
+    ~TraceData()
+    {
+        if(!events.isEmpty())
+            write();
+    }
+
+    bool write();
+
+    QElapsedTimer timer;
+    QString fileName;
+
+    QMutex mutex;
+    QList<TraceEvent> events;
+    int droppedEvents = 0;
+};
+
+TraceData& traceData()
+{
+    static TraceData data;
+    return data;
+}
+
+bool TraceData::write()
+{
+    QMutexLocker locker(&mutex);
+
+    QFile f(fileName);
+    if(!f.open(QFile::WriteOnly | QFile::Truncate))
+    {
+        qCWarning(lcTrace) << "Cannot write trace:" << f.errorString();
+        return false;
+    }
+
+    const qint64 pid = QCoreApplication::applicationPid();
+
+    //Names are literals without characters to escape
+    QByteArray buf;
+    buf.reserve(64 * 1024);
+    buf.append("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+    for(int i = 0; i < events.size(); i++)
+    {
+        const TraceEvent& e = events.at(i);
+        buf.append("{\"name\":\"").append(e.name)
+            .append("\",\"cat\":\"").append(e.category)
+            .append("\",\"ph\":\"X\",\"ts\":").append(QByteArray::number(double(e.start) / 1000.0, 'f', 3))
+            .append(",\"dur\":").append(QByteArray::number(double(e.duration) / 1000.0, 'f', 3))
+            .append(",\"pid\":").append(QByteArray::number(pid))
+            .append(",\"tid\":").append(QByteArray::number(e.threadId))
+            .append('}');
+        if(i < events.size() - 1)
+            buf.append(',');
+        buf.append('\n');
+
+        if(buf.size() > 60 * 1024)
+        {
+            f.write(buf);
+            buf.clear();
+        }
+    }
+
+    buf.append("]}\n");
+    f.write(buf);
+
+    if(droppedEvents > 0)
+        qCWarning(lcTrace) << "Trace buffer full," << droppedEvents << "events dropped";
+
+    return f.error() == QFile::NoError;
+}
+
+} // namespace
+
+QAtomicInt Tracer::s_state(-1);
+
+void Tracer::setEnabled(bool val)
+{
+    if(val)
+        traceData(); //Start clock
+    s_state.storeRelaxed(val ? 1 : 0);
+}
+
+qint64 Tracer::now()
+{
+    return traceData().timer.nsecsElapsed();
+}
+
+void Tracer::addEvent(const char *name, const char *category, qint64 startNs, qint64 endNs)
+{
+    TraceData& data = traceData();
+
+    TraceEvent e;
+    e.name = name;
+    e.category = category;
+    e.start = startNs;
+    e.duration = endNs - startNs;
+    e.threadId = quint64(quintptr(QThread::currentThreadId()));
+
+    QMutexLocker locker(&data.mutex);
+    if(data.events.size() >= MaxEvents)
+    {
+        data.droppedEvents++;
+        return;
+    }
+    data.events.append(e);
+}
+
+bool Tracer::flush()
+{
+    if(!isEnabled())
+        return false;
+    return traceData().write();
+}
+
+bool Tracer::initState()
+{
+    //Environment variable or logging rules
+    const bool enabled = qEnvironmentVariableIsSet("SSPLIB_TRACE_FILE") || lcTrace().isDebugEnabled();
+    setEnabled(enabled);
+    return enabled;
+}
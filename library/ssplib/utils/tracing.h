@@ -0,0 +1,85 @@
+#ifndef SSPLIB_TRACING_H
+#define SSPLIB_TRACING_H
+
+#include <QAtomicInt>
+#include <QLoggingCategory>
+
+namespace ssplib {
+
+namespace utils {
+
+Q_DECLARE_LOGGING_CATEGORY(lcTrace)
+
+//Scoped trace points exported as Chrome trace-event JSON
+//Enable with QT_LOGGING_RULES="ssplib.trace.debug=true" or by setting
+//SSPLIB_TRACE_FILE to output file path (default "ssplib-trace.json").
+//Events are kept in memory and written at exit or on flush().
+//Open output in chrome://tracing or https://ui.perfetto.dev
+//When disabled a trace point costs one atomic load.
+class Tracer
+{
+public:
+    static inline bool isEnabled()
+    {
+        const int state = s_state.loadRelaxed();
+        return state < 0 ? initState() : state;
+    }
+
+    static void setEnabled(bool val);
+
+    //Nanoseconds since tracer start
+    static qint64 now();
+
+    //Name and category must be string literals, they are stored by pointer
+    static void addEvent(const char *name, const char *category, qint64 startNs, qint64 endNs);
+
+    //Write all events collected so far, returns false on errors
+    static bool flush();
+
+private:
+    static bool initState();
+
+    static QAtomicInt s_state; //-1 not checked yet, 0 disabled, 1 enabled
+};
+
+class TraceScope
+{
+public:
+    inline explicit TraceScope(const char *name, const char *category = "ssplib") :
+        m_name(name),
+        m_category(category),
+        m_start(Tracer::isEnabled() ? Tracer::now() : -1)
+    {
+
+    }
+
+    inline ~TraceScope()
+    {
+        if(m_start >= 0)
+            Tracer::addEvent(m_name, m_category, m_start, Tracer::now());
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char *m_name;
+    const char *m_category;
+    qint64 m_start;
+};
+
+} // namespace utils
+
+} // namespace ssplib
+
+#define SSPLIB_TRACE_CONCAT_IMPL(a, b) a##b
+#define SSPLIB_TRACE_CONCAT(a, b) SSPLIB_TRACE_CONCAT_IMPL(a, b)
+
+//Trace enclosing scope, name must be a string literal
+#define SSPLIB_TRACE_SCOPE(name) \
+    ssplib::utils::TraceScope SSPLIB_TRACE_CONCAT(ssplib_trace_scope_, __LINE__)(name)
+
+#define SSPLIB_TRACE_SCOPE_CAT(name, category) \
+    ssplib::utils::TraceScope SSPLIB_TRACE_CONCAT(ssplib_trace_scope_, __LINE__)(name, category)
+
+#endif // SSPLIB_TRACING_H
@@ -0,0 +1,199 @@
+#include "planlinter.h"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QTextStream>
+#include <QThreadPool>
+
+#include <algorithm>
+
+//Exit codes
+enum LintExitCode
+{
+    LintOk = 0,
+    LintIssuesFound = 1,
+    LintUsageError = 2,
+    LintIOError = 3
+};
+
+static QStringList collectPlans(const QStringList& paths, QTextStream& err, bool& ok)
+{
+    QStringList files;
+    ok = true;
+
+    for(const QString& path : paths)
+    {
+        QFileInfo info(path);
+        if(info.isDir())
+        {
+            QDirIterator it(path, QStringList{QLatin1String("*.svg")}, QDir::Files,
+                            QDirIterator::Subdirectories);
+            while(it.hasNext())
+                files.append(it.next());
+        }
+        else if(info.isFile())
+        {
+            files.append(info.filePath());
+        }
+        else
+        {
+            err << QCoreApplication::translate("main", "%1: no such file or directory").arg(path) << Qt::endl;
+            ok = false;
+        }
+    }
+
+    //Stable output order regardless of file system
+    std::sort(files.begin(), files.end());
+    files.erase(std::unique(files.begin(), files.end()), files.end());
+    return files;
+}
+
+static QString formatMs(qint64 ns)
+{
+    return QString::number(double(ns) / 1000000.0, 'f', 2);
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName(QLatin1String("ssp-lint"));
+    QCoreApplication::setApplicationVersion(QLatin1String(APPVERSION));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        QCoreApplication::translate("main", "Validate station plan SVG files and their info XML."));
+    parser.addHelpOption();
+    parser.addVersionOption();
+    parser.addPositionalArgument(QLatin1String("paths"),
+                                 QCoreApplication::translate("main", "SVG files or directories to scan recursively."),
+                                 QLatin1String("<paths...>"));
+
+    QCommandLineOption jobsOption({QLatin1String("j"), QLatin1String("jobs")},
+                                  QCoreApplication::translate("main", "Number of parallel jobs, default is all cores."),
+                                  QLatin1String("count"));
+    parser.addOption(jobsOption);
+
+    QCommandLineOption requireXmlOption(QLatin1String("require-xml"),
+                                        QCoreApplication::translate("main", "Report plans without info XML."));
+    parser.addOption(requireXmlOption);
+
+    QCommandLineOption timesOption(QLatin1String("times"),
+                                   QCoreApplication::translate("main", "Print parse time of each file."));
+    parser.addOption(timesOption);
+
+    QCommandLineOption quietOption({QLatin1String("q"), QLatin1String("quiet")},
+                                   QCoreApplication::translate("main", "Only print issues, no summary."));
+    parser.addOption(quietOption);
+
+    parser.process(app);
+
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    if(parser.positionalArguments().isEmpty())
+    {
+        err << QCoreApplication::translate("main", "No paths given") << Qt::endl;
+        parser.showHelp(LintUsageError);
+    }
+
+    if(parser.isSet(jobsOption))
+    {
+        bool ok = false;
+        const int jobs = parser.value(jobsOption).toInt(&ok);
+        if(!ok || jobs < 1)
+        {
+            err << QCoreApplication::translate("main", "Invalid job count: %1").arg(parser.value(jobsOption)) << Qt::endl;
+            return LintUsageError;
+        }
+        QThreadPool::globalInstance()->setMaxThreadCount(jobs);
+    }
+
+    const bool requireXml = parser.isSet(requireXmlOption);
+
+    bool pathsOk = true;
+    const QStringList files = collectPlans(parser.positionalArguments(), err, pathsOk);
+    if(!pathsOk)
+        return LintUsageError;
+
+    QElapsedTimer totalTimer;
+    totalTimer.start();
+
+    //Each job writes its own slot, list is not resized while running
+    QList<PlanLintResult> results(files.size());
+    PlanLintResult *resultData = results.data();
+
+    for(int i = 0; i < files.size(); i++)
+    {
+        const QString fileName = files.at(i);
+        QThreadPool::globalInstance()->start([resultData, i, fileName, requireXml]()
+                                             {
+                                                 resultData[i] = lintPlan(fileName, requireXml);
+                                             });
+    }
+
+    QThreadPool::globalInstance()->waitForDone();
+    const qint64 totalNs = totalTimer.nsecsElapsed();
+
+    //Print in file order, format is understood by CI problem matchers
+    int issueCount = 0;
+    int failedPlans = 0;
+    bool ioError = false;
+    const PlanLintResult *slowest = nullptr;
+
+    for(const PlanLintResult& result : std::as_const(results))
+    {
+        for(const PlanLintIssue& issue : result.issues)
+        {
+            out << issue.fileName;
+            if(issue.line > 0)
+                out << ':' << issue.line;
+            out << ": error: " << issue.message << '\n';
+        }
+
+        if(parser.isSet(timesOption))
+        {
+            out << result.svgFileName << ": time: svg " << formatMs(result.svgParseNs) << " ms";
+            if(!result.xmlFileName.isEmpty())
+                out << ", xml " << formatMs(result.xmlParseNs) << " ms";
+            out << '\n';
+        }
+
+        issueCount += result.issues.size();
+        if(!result.issues.isEmpty())
+            failedPlans++;
+        if(result.ioError)
+            ioError = true;
+
+        if(!slowest || result.svgParseNs + result.xmlParseNs > slowest->svgParseNs + slowest->xmlParseNs)
+            slowest = &result;
+    }
+
+    if(!parser.isSet(quietOption))
+    {
+        out << QCoreApplication::translate("main", "Checked %1 plans in %2 ms using %3 threads: %4 issues in %5 plans")
+                   .arg(QString::number(files.size()),
+                        formatMs(totalNs),
+                        QString::number(QThreadPool::globalInstance()->maxThreadCount()),
+                        QString::number(issueCount),
+                        QString::number(failedPlans))
+            << '\n';
+
+        if(slowest)
+        {
+            out << QCoreApplication::translate("main", "Slowest plan: %1 (%2 ms)")
+                       .arg(slowest->svgFileName, formatMs(slowest->svgParseNs + slowest->xmlParseNs))
+                << '\n';
+        }
+    }
+
+    out.flush();
+
+    if(ioError)
+        return LintIOError;
+    if(issueCount > 0)
+        return LintIssuesFound;
+    return LintOk;
+}
@@ -0,0 +1,138 @@
+#include "planlinter.h"
+
+#include <ssplib/stationplan.h>
+#include <ssplib/parsing/streamparser.h>
+#include <ssplib/parsing/stationinfoparser.h>
+
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+
+using namespace ssplib;
+
+static void addIssue(PlanLintResult& result, const QString& fileName, qint64 line, const QString& msg)
+{
+    PlanLintIssue issue;
+    issue.fileName = fileName;
+    issue.line = line;
+    issue.message = msg;
+    result.issues.append(issue);
+}
+
+static void checkConnections(const QString& fileName, const QList<TrackConnectionItem>& connections,
+                             const QHash<QChar, int>& gates, const QHash<int, QString>& tracks,
+                             PlanLintResult& result)
+{
+    for(const TrackConnectionItem& conn : connections)
+    {
+        const TrackConnectionInfo& info = conn.info;
+        const QString connName = QStringLiteral("(%1,%2,%3)")
+                                     .arg(QString(info.gateLetter),
+                                          QString::number(info.gateTrackPos),
+                                          QString::number(info.stationTrackPos));
+
+        auto gate = gates.constFind(info.gateLetter);
+        if(gate == gates.cend())
+        {
+            addIssue(result, fileName, 0,
+                     QStringLiteral("Connection %1 names non-existent gate %2")
+                         .arg(connName, QString(info.gateLetter)));
+        }
+        else if(gate.value() >= 0 && info.gateTrackPos >= gate.value())
+        {
+            //Out track count is known only from info XML
+            addIssue(result, fileName, 0,
+                     QStringLiteral("Connection %1 names gate track %2 but gate %3 has %4 tracks")
+                         .arg(connName, QString::number(info.gateTrackPos),
+                              QString(info.gateLetter), QString::number(gate.value())));
+        }
+
+        if(!tracks.contains(info.stationTrackPos))
+        {
+            addIssue(result, fileName, 0,
+                     QStringLiteral("Connection %1 names non-existent track at position %2")
+                         .arg(connName, QString::number(info.stationTrackPos)));
+        }
+    }
+}
+
+PlanLintResult lintPlan(const QString &svgFileName, bool requireXml)
+{
+    PlanLintResult result;
+    result.svgFileName = svgFileName;
+
+    QElapsedTimer timer;
+
+    //Parse SVG, geometry is not lazy so broken elements are reported too
+    StationPlan svgPlan;
+    QFile svgFile(svgFileName);
+    if(!svgFile.open(QFile::ReadOnly))
+    {
+        result.ioError = true;
+        addIssue(result, svgFileName, 0, svgFile.errorString());
+        return result;
+    }
+
+    timer.start();
+    StreamParser svgParser(&svgPlan, &svgFile);
+    svgParser.setWarningCallback([&result, &svgFileName](const QString& msg, qint64 line)
+                                 {
+                                     addIssue(result, svgFileName, line, msg);
+                                 });
+    svgParser.parse();
+    result.svgParseNs = timer.nsecsElapsed();
+    svgFile.close();
+
+    //Parse info XML
+    const QFileInfo svgInfo(svgFileName);
+    const QString xmlFileName = svgInfo.dir().filePath(svgInfo.completeBaseName() + QLatin1String(".xml"));
+
+    StationPlan xmlPlan;
+    QFile xmlFile(xmlFileName);
+    if(xmlFile.exists())
+    {
+        if(!xmlFile.open(QFile::ReadOnly))
+        {
+            result.ioError = true;
+            addIssue(result, xmlFileName, 0, xmlFile.errorString());
+            return result;
+        }
+
+        result.xmlFileName = xmlFileName;
+
+        timer.start();
+        StationInfoReader xmlReader(&xmlPlan, &xmlFile);
+        xmlReader.setWarningCallback([&result, &xmlFileName](const QString& msg, qint64 line)
+                                     {
+                                         addIssue(result, xmlFileName, line, msg);
+                                     });
+        xmlReader.parse();
+        result.xmlParseNs = timer.nsecsElapsed();
+    }
+    else if(requireXml)
+    {
+        addIssue(result, xmlFileName, 0, QLatin1String("Missing station info XML"));
+    }
+
+    //Gates with out track count, -1 if unknown
+    QHash<QChar, int> gates;
+    for(const LabelItem& item : std::as_const(svgPlan.labels))
+        gates.insert(item.gateLetter, -1);
+    for(const LabelItem& item : std::as_const(xmlPlan.labels))
+        gates.insert(item.gateLetter, item.gateOutTrkCount);
+
+    //Track names by position, SVG elements with same position belong to same track
+    QHash<int, QString> tracks;
+    for(const TrackItem& item : std::as_const(svgPlan.platforms))
+        tracks.insert(item.trackPos, item.trackName);
+    for(const TrackItem& item : std::as_const(xmlPlan.platforms))
+        tracks.insert(item.trackPos, item.trackName);
+
+    checkConnections(svgFileName, svgPlan.trackConnections, gates, tracks, result);
+    if(!result.xmlFileName.isEmpty())
+        checkConnections(xmlFileName, xmlPlan.trackConnections, gates, tracks, result);
+
+    return result;
+}
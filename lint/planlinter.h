@@ -0,0 +1,34 @@
+#ifndef PLANLINTER_H
+#define PLANLINTER_H
+
+#include <QList>
+#include <QString>
+
+struct PlanLintIssue
+{
+    QString fileName;
+    qint64 line = 0; //0 if not related to a line
+    QString message;
+};
+
+struct PlanLintResult
+{
+    QString svgFileName;
+    QString xmlFileName; //Empty if plan has no info XML
+
+    QList<PlanLintIssue> issues;
+
+    qint64 svgParseNs = 0;
+    qint64 xmlParseNs = 0;
+
+    //Files could not be opened, not a plan issue
+    bool ioError = false;
+};
+
+//Loads SVG plan and its info XML (same base name, .xml suffix) and checks them
+//Reports unparseable tags, invalid info entries, duplicate track positions and
+//connections to gates or tracks which do not exist in SVG or info XML.
+//Can be called from multiple threads at the same time.
+PlanLintResult lintPlan(const QString& svgFileName, bool requireXml);
+
+#endif // PLANLINTER_H
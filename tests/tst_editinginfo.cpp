@@ -0,0 +1,84 @@
+#include <QtTest>
+
+#include <QDomDocument>
+#include <QSet>
+
+#include <ssplib/stationplan.h>
+#include <ssplib/parsing/domparser.h>
+#include <ssplib/parsing/editinginfo.h>
+#include <ssplib/utils/svg_constants.h>
+
+using namespace ssplib;
+
+//Element without id comes first, its generated id must not take the explicit one
+static const char svgWithCollidingIds[] =
+    "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"100\" height=\"50\">\n"
+    " <path d=\"m 0,0 h 10\"/>\n"
+    " <g>\n"
+    "  <path d=\"m 0,5 h 10\"/>\n"
+    "  <path id=\"path_0\" d=\"m 0,10 h 10\"/>\n"
+    " </g>\n"
+    " <path id=\"path_1\" d=\"m 0,15 h 10\"/>\n"
+    " <path id=\"path_1\" d=\"m 0,20 h 10\"/>\n"
+    "</svg>\n";
+
+class TestEditingInfo : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void generatedIdsDoNotCollide();
+    void generateIdSkipsReserved();
+};
+
+void TestEditingInfo::generatedIdsDoNotCollide()
+{
+    QDomDocument doc;
+    QVERIFY(bool(doc.setContent(QByteArray(svgWithCollidingIds))));
+
+    EditingInfo info;
+
+    //Give elements without id a generated one, like the editor does
+    info.setCallback([&info](QDomElement& e)
+                     {
+                         if(!e.hasAttribute(svg_attr::ID))
+                             e.setAttribute(svg_attr::ID, info.generateId(QLatin1String("path_")));
+                     });
+
+    StationPlan plan;
+    DOMParser parser(&doc, &plan, &info);
+    QVERIFY(parser.parse());
+
+    const QDomNodeList paths = doc.elementsByTagName(QLatin1String("path"));
+    QCOMPARE(paths.size(), 5);
+
+    QSet<QString> ids;
+    for(int i = 0; i < paths.size(); i++)
+    {
+        const QString id = paths.at(i).toElement().attribute(svg_attr::ID);
+        QVERIFY(!id.isEmpty());
+        QVERIFY2(!ids.contains(id), qPrintable(id));
+        ids.insert(id);
+    }
+
+    //Explicit ids are kept, only duplicate explicit id is renamed
+    QCOMPARE(paths.at(2).toElement().attribute(svg_attr::ID), QStringLiteral("path_0"));
+    QCOMPARE(paths.at(3).toElement().attribute(svg_attr::ID), QStringLiteral("path_1"));
+    QVERIFY(paths.at(4).toElement().attribute(svg_attr::ID) != QStringLiteral("path_1"));
+
+    QCOMPARE(info.namedElements.value(QStringLiteral("path_0")), paths.at(2).toElement());
+}
+
+void TestEditingInfo::generateIdSkipsReserved()
+{
+    EditingInfo info;
+    info.reserveId(QStringLiteral("path_0"));
+    info.reserveId(QStringLiteral("path_2"));
+
+    QCOMPARE(info.generateId(QStringLiteral("path_")), QStringLiteral("path_1"));
+    QCOMPARE(info.generateId(QStringLiteral("path_")), QStringLiteral("path_3"));
+}
+
+QTEST_GUILESS_MAIN(TestEditingInfo)
+
+#include "tst_editinginfo.moc"
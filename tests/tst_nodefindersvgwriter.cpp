@@ -0,0 +1,116 @@
+#include <QtTest>
+
+#include <QBuffer>
+#include <QDomDocument>
+#include <QXmlStreamReader>
+
+#include "nodefindersvgwriter.h"
+
+static const char svgWithDocType[] =
+    "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+    "<!DOCTYPE svg PUBLIC \"-//W3C//DTD SVG 1.1//EN\" \"http://www.w3.org/Graphics/SVG/1.1/DTD/svg11.dtd\">\n"
+    "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"100\" height=\"50\">\n"
+    " <!-- station -->\n"
+    " <g id=\"layer1\">\n"
+    "  <path id=\"path_1\" d=\"m 0,0 h 10\" trackpos=\"1\"/>\n"
+    "  <line x1=\"0\" y1=\"5\" x2=\"10\" y2=\"5\"/>\n"
+    " </g>\n"
+    "</svg>\n";
+
+//Load like NodeFinderSVGConverter::loadDocument()
+static bool loadDocument(QDomDocument& doc, const QByteArray& data)
+{
+    QXmlStreamReader xml(data);
+    xml.setNamespaceProcessing(false);
+    return bool(doc.setContent(&xml, xml.namespaceProcessing()));
+}
+
+static QByteArray saveDocument(const QDomDocument& doc, const NodeFinderElementClass::ElementHash& fakeIds)
+{
+    QBuffer buf;
+    buf.open(QIODevice::WriteOnly);
+    NodeFinderSVGWriter writer(doc, fakeIds);
+    if(!writer.write(&buf))
+        return QByteArray();
+    return buf.data();
+}
+
+class TestNodeFinderSVGWriter : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void roundTripDocType();
+    void roundTripWithoutDocType();
+    void skipGeneratedIds();
+};
+
+void TestNodeFinderSVGWriter::roundTripDocType()
+{
+    QDomDocument doc;
+    QVERIFY(loadDocument(doc, svgWithDocType));
+    QCOMPARE(doc.doctype().name(), QStringLiteral("svg"));
+
+    const QByteArray saved = saveDocument(doc, {});
+    QVERIFY(!saved.isEmpty());
+
+    //Document type must follow xml declaration and precede root element
+    const qsizetype declPos = saved.indexOf("<?xml");
+    const qsizetype docTypePos = saved.indexOf("<!DOCTYPE svg");
+    const qsizetype rootPos = saved.indexOf("<svg");
+    QVERIFY(declPos >= 0);
+    QVERIFY(docTypePos > declPos);
+    QVERIFY(rootPos > docTypePos);
+    QCOMPARE(saved.count("<!DOCTYPE"), qsizetype(1));
+
+    QDomDocument reloaded;
+    QVERIFY(loadDocument(reloaded, saved));
+    QCOMPARE(reloaded.doctype().name(), doc.doctype().name());
+    QCOMPARE(reloaded.doctype().publicId(), doc.doctype().publicId());
+    QCOMPARE(reloaded.doctype().systemId(), doc.doctype().systemId());
+    QCOMPARE(reloaded.documentElement().tagName(), QStringLiteral("svg"));
+    QCOMPARE(reloaded.elementsByTagName(QLatin1String("path")).size(), 1);
+    QCOMPARE(reloaded.elementsByTagName(QLatin1String("line")).size(), 1);
+}
+
+void TestNodeFinderSVGWriter::roundTripWithoutDocType()
+{
+    QByteArray data(svgWithDocType);
+    const qsizetype start = data.indexOf("<!DOCTYPE");
+    data.remove(start, data.indexOf('\n', start) - start + 1);
+
+    QDomDocument doc;
+    QVERIFY(loadDocument(doc, data));
+    QVERIFY(doc.doctype().name().isEmpty());
+
+    const QByteArray saved = saveDocument(doc, {});
+    QVERIFY(!saved.contains("<!DOCTYPE"));
+
+    QDomDocument reloaded;
+    QVERIFY(loadDocument(reloaded, saved));
+    QCOMPARE(reloaded.elementsByTagName(QLatin1String("path")).size(), 1);
+}
+
+void TestNodeFinderSVGWriter::skipGeneratedIds()
+{
+    QDomDocument doc;
+    QVERIFY(loadDocument(doc, svgWithDocType));
+
+    //Give line a generated id, path keeps its own
+    QDomElement line = doc.elementsByTagName(QLatin1String("line")).at(0).toElement();
+    line.setAttribute(QLatin1String("id"), QLatin1String("line_2"));
+
+    NodeFinderElementClass::ElementHash fakeIds;
+    fakeIds.insert(QLatin1String("line_2"), line);
+
+    const QByteArray saved = saveDocument(doc, fakeIds);
+    QVERIFY(!saved.contains("line_2"));
+    QVERIFY(saved.contains("id=\"path_1\""));
+
+    //Document is not modified by saving
+    QCOMPARE(line.attribute(QLatin1String("id")), QStringLiteral("line_2"));
+}
+
+QTEST_GUILESS_MAIN(TestNodeFinderSVGWriter)
+
+#include "tst_nodefindersvgwriter.moc"
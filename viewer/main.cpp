@@ -1,6 +1,7 @@
 #include "mainwindow.h"
 
 #include <QApplication>
+#include <QCommandLineParser>
 
 int main(int argc, char *argv[])
 {
@@ -8,8 +9,25 @@ int main(int argc, char *argv[])
     QApplication::setApplicationDisplayName(QLatin1String("SVG Station Plan Viewer"));
     QApplication a(argc, argv);
 
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    parser.addPositionalArgument(QLatin1String("file"),
+                                 QApplication::translate("main", "SVG file to open."),
+                                 QLatin1String("[file]"));
+
+    //Debug option to check plan memory cost
+    QCommandLineOption memoryStatsOption(QLatin1String("memory-stats"),
+                                         QApplication::translate("main", "Print memory usage after loading and on exit."));
+    parser.addOption(memoryStatsOption);
+    parser.process(a);
+
     MainWindow w;
+    w.setDumpMemoryUsage(parser.isSet(memoryStatsOption));
     w.show();
 
+    const QStringList args = parser.positionalArguments();
+    if(!args.isEmpty())
+        w.loadFile(args.first());
+
     return a.exec();
 }
@@ -17,16 +17,15 @@
 MainWindow::MainWindow(QWidget *parent) :
     QMainWindow(parent),
     ui(new Ui::MainWindow),
-    stationPlan(nullptr),
-    zoom(0)
+    planState(nullptr),
+    zoom(0),
+    dumpMemory(false)
 {
     ui->setupUi(this);
 
-    mSvg = new QSvgRenderer(this);
-
-    stationPlan = new ssplib::StationPlan;
-    viewer = new ssplib::SSPViewer(stationPlan);
-    viewer->setRenderer(mSvg);
+    planState = new ssplib::StationPlanState;
+    viewer = new ssplib::SSPViewer(nullptr);
+    viewer->setPlanState(planState);
 
     scrollArea = new QScrollArea(this);
     scrollArea->setBackgroundRole(QPalette::Dark);
@@ -74,10 +73,14 @@ MainWindow::MainWindow(QWidget *parent) :
 
 MainWindow::~MainWindow()
 {
+    //Lazy geometry may have grown after drawing
+    if(dumpMemory)
+        dumpMemoryUsage();
+
     delete ui;
 
-    delete stationPlan;
-    stationPlan = nullptr;
+    delete planState;
+    planState = nullptr;
 }
 
 void MainWindow::loadSVG()
@@ -88,47 +91,55 @@ void MainWindow::loadSVG()
     if(fileName.isEmpty())
         return;
 
-    QFile f(fileName);
-    if(!f.open(QFile::ReadOnly))
-    {
-        qDebug() << f.errorString();
-        return;
-    }
+    loadFile(fileName);
+}
 
-    ssplib::StreamParser parser(stationPlan, &f);
-    if(!parser.parse())
+bool MainWindow::loadFile(const QString &fileName)
+{
+    //Plan and renderer are shared with other viewers of same file
+    ssplib::SSPCachedPlan cached = ssplib::SSPPlanCache::instance()->load(fileName);
+    if(!cached.isValid())
     {
-        qDebug() << "Parsing error";
-        return;
+        qDebug() << "Loading error";
+        return false;
     }
 
-    f.reset();
-    QXmlStreamReader xml(&f);
-    if(!mSvg->load(&xml))
-    {
-        qDebug() << "SVG loading error";
-        return;
-    }
+    stationPlan = cached.plan;
+    mSvg = cached.renderer;
+    viewer->setPlan(stationPlan.data());
+    viewer->setRenderer(mSvg.data());
 
     //Show everithing
-    for(ssplib::ItemBase& label : stationPlan->labels)
-    {
-        label.visible = true;
-    }
-    for(ssplib::ItemBase& track : stationPlan->platforms)
-    {
-        track.visible = true;
-    }
-    for(ssplib::ItemBase& track : stationPlan->trackConnections)
-    {
-        track.visible = true;
-    }
-    stationPlan->drawLabels = true;
-    stationPlan->drawTracks = true;
-    stationPlan->platformPenWidth = 2;
+    planState->reset(stationPlan.data());
+    planState->setAllVisible(true);
+    planState->drawLabels = true;
+    planState->drawTracks = true;
+    planState->platformPenWidth = 2;
+    viewer->update();
 
     setZoom(100);
     zoomToFit();
+
+    if(dumpMemory)
+        dumpMemoryUsage();
+
+    return true;
+}
+
+void MainWindow::dumpMemoryUsage() const
+{
+    if(stationPlan)
+    {
+        qInfo().noquote() << "Plan" << stationPlan->stationName << "memory usage:\n"
+                          << stationPlan->memoryUsage().toString();
+    }
+
+    qInfo().noquote() << "View state memory usage:\n" << planState->memoryUsage().toString();
+
+    ssplib::SSPPlanCache *cache = ssplib::SSPPlanCache::instance();
+    qInfo().noquote() << "Plan cache:" << cache->count() << "entries,"
+                      << cache->hitCount() << "hits," << cache->missCount() << "misses\n"
+                      << cache->memoryUsage().toString();
 }
 
 void MainWindow::setZoom(int val)
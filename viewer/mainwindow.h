@@ -2,6 +2,7 @@
 #define MAINWINDOW_H
 
 #include <QMainWindow>
+#include <QSharedPointer>
 
 QT_BEGIN_NAMESPACE
 namespace Ui { class MainWindow; }
@@ -14,6 +15,7 @@ QT_END_NAMESPACE
 namespace ssplib {
 class SSPViewer;
 class StationPlan;
+class StationPlanState;
 } // namespace ssplib
 
 class MainWindow : public QMainWindow
@@ -24,6 +26,11 @@ public:
     MainWindow(QWidget *parent = nullptr);
     ~MainWindow();
 
+    bool loadFile(const QString& fileName);
+
+    inline void setDumpMemoryUsage(bool val) { dumpMemory = val; }
+    void dumpMemoryUsage() const;
+
 public slots:
     void loadSVG();
     void setZoom(int val);
@@ -37,8 +44,10 @@ private:
     ssplib::SSPViewer *viewer;
 
 private:
-    QSvgRenderer *mSvg;
-    ssplib::StationPlan *stationPlan;
+    QSharedPointer<QSvgRenderer> mSvg;
+    QSharedPointer<const ssplib::StationPlan> stationPlan;
+    ssplib::StationPlanState *planState;
     int zoom;
+    bool dumpMemory;
 };
 #endif // MAINWINDOW_H